@@ -0,0 +1,54 @@
+#include "Arena.h"
+#include "assert.h"
+
+Arena *Arena::_arenas = NULL;
+
+Arena::Arena(const char *name, void *buffer, size_t size)
+        : _name(name)
+        , _buffer((uint8_t*)buffer)
+        , _size(size)
+        , _used(0)
+        , _highwater(0) {
+    // line up the start, and drop any partial word at the end
+    size_t skew = -(uintptr_t)_buffer & 7;
+    if (skew > _size) {
+        skew = _size;
+    }
+    _buffer += skew;
+    _size = (_size - skew) & ~(size_t)7;
+
+    _next = _arenas;
+    _arenas = this;
+}
+
+Arena::~Arena() {
+    for (Arena **a = &_arenas; *a; a = &(*a)->_next) {
+        if (*a == this) {
+            *a = _next;
+            break;
+        }
+    }
+}
+
+void *Arena::alloc(size_t size) {
+    // round up to nearest uint64_t
+    size = (size + (8 - 1)) & ~(size_t)(8 - 1);
+
+    // enough space?
+    if (size > _size - _used) {
+        return NULL;
+    }
+
+    void *p = &_buffer[_used];
+    _used += size;
+    if (_used > _highwater) {
+        _highwater = _used;
+    }
+
+    return p;
+}
+
+void Arena::rollback(mark_t mark) {
+    assert(mark <= _used);
+    _used = mark;
+}
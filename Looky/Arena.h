@@ -0,0 +1,66 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Bump allocator over a fixed chunk of memory
+ *
+ * No free, but you can take a mark and roll back to it later, or reset
+ * the whole thing. Allocations are always 64-bit aligned. Arenas link
+ * themselves into a global list so we can report on them.
+ *
+ * Not thread-safe, keep each arena to one thread.
+ */
+class Arena {
+public:
+    typedef size_t mark_t;
+
+    Arena(const char *name, void *buffer, size_t size);
+    ~Arena();
+
+    // returns NULL if we're out of space
+    void *alloc(size_t size);
+
+    mark_t mark() const { return _used; }
+    void rollback(mark_t mark);
+    void reset() { rollback(0); }
+
+    // usage info
+    const char *name() const { return _name; }
+    size_t size() const { return _size; }
+    size_t used() const { return _used; }
+    size_t highwater() const { return _highwater; }
+
+    // iterate over all arenas
+    static Arena *first() { return _arenas; }
+    Arena *next() const { return _next; }
+
+private:
+    const char *_name;
+    uint8_t *_buffer;
+    size_t _size;
+    size_t _used;
+    size_t _highwater;
+
+    Arena *_next;
+    static Arena *_arenas;
+};
+
+// Rolls an arena back to where it was when we were created
+class ArenaScope {
+public:
+    ArenaScope(Arena &arena)
+            : _arena(arena)
+            , _mark(arena.mark()) {}
+    ~ArenaScope() {
+        _arena.rollback(_mark);
+    }
+
+private:
+    Arena &_arena;
+    Arena::mark_t _mark;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include "Damage.h"
+
+static inline int min(int a, int b) { return a < b ? a : b; }
+static inline int max(int a, int b) { return a > b ? a : b; }
+
+static inline int area(int x1, int y1, int x2, int y2) {
+    return (x2-x1)*(y2-y1);
+}
+
+void Damage::add(int x, int y, int w, int h) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    rect r = {x, y, x+w, y+h};
+    add(r);
+}
+
+void Damage::add(const Damage &d) {
+    for (int i = 0; i < d._count; i++) {
+        add(d._rects[i]);
+    }
+}
+
+void Damage::add(rect r) {
+    // soak up anything we overlap or touch, this may grow us into
+    // rects we've already passed, so start over when we merge
+    for (int i = 0; i < _count; i++) {
+        const rect &o = _rects[i];
+        if (o.x1 <= r.x2 && r.x1 <= o.x2 &&
+            o.y1 <= r.y2 && r.y1 <= o.y2) {
+            r.x1 = min(r.x1, o.x1);
+            r.y1 = min(r.y1, o.y1);
+            r.x2 = max(r.x2, o.x2);
+            r.y2 = max(r.y2, o.y2);
+            remove(i);
+            i = -1;
+        }
+    }
+
+    if (_count < MAX_RECTS) {
+        _rects[_count++] = r;
+        return;
+    }
+
+    // out of room, merge with whatever costs the least extra area
+    int best = 0;
+    int bestcost = 0;
+    for (int i = 0; i < _count; i++) {
+        const rect &o = _rects[i];
+        int cost = area(min(r.x1, o.x1), min(r.y1, o.y1),
+                        max(r.x2, o.x2), max(r.y2, o.y2))
+                - area(o.x1, o.y1, o.x2, o.y2);
+        if (i == 0 || cost < bestcost) {
+            best = i;
+            bestcost = cost;
+        }
+    }
+
+    rect o = _rects[best];
+    remove(best);
+    r.x1 = min(r.x1, o.x1);
+    r.y1 = min(r.y1, o.y1);
+    r.x2 = max(r.x2, o.x2);
+    r.y2 = max(r.y2, o.y2);
+    add(r);
+}
+
+void Damage::remove(int i) {
+    _rects[i] = _rects[_count-1];
+    _count -= 1;
+}
+
+bool Damage::intersects(int x, int y, int w, int h) const {
+    for (int i = 0; i < _count; i++) {
+        const rect &o = _rects[i];
+        if (o.x1 < x+w && x < o.x2 &&
+            o.y1 < y+h && y < o.y2) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Damage::clip(int &x, int &y, int &w, int &h) const {
+    rect c = {0, 0, 0, 0};
+    for (int i = 0; i < _count; i++) {
+        const rect &o = _rects[i];
+        rect r = {max(x, o.x1), max(y, o.y1), min(x+w, o.x2), min(y+h, o.y2)};
+        if (r.x1 >= r.x2 || r.y1 >= r.y2) {
+            continue;
+        }
+
+        if (c.x1 == c.x2) {
+            c = r;
+        } else {
+            c.x1 = min(c.x1, r.x1);
+            c.y1 = min(c.y1, r.y1);
+            c.x2 = max(c.x2, r.x2);
+            c.y2 = max(c.y2, r.y2);
+        }
+    }
+
+    if (c.x1 == c.x2) {
+        return false;
+    }
+
+    x = c.x1;
+    y = c.y1;
+    w = c.x2 - c.x1;
+    h = c.y2 - c.y1;
+    return true;
+}
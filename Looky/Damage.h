@@ -0,0 +1,48 @@
+#ifndef DAMAGE_H
+#define DAMAGE_H
+
+/**
+ * Bounded list of damaged rectangles
+ *
+ * Rects that overlap or touch get merged, and if we run out of room
+ * we merge with whichever rect grows the least. So this over-reports
+ * damage sometimes, but never under-reports.
+ */
+class Damage {
+public:
+    static const int MAX_RECTS = 8;
+
+    Damage() : _count(0) {}
+
+    void add(int x, int y, int w, int h);
+    void add(const Damage &d);
+    void clear() { _count = 0; }
+
+    bool intersects(int x, int y, int w, int h) const;
+
+    // shrink a rect to the bounds of the damage inside it, false if none
+    // of it is damaged
+    bool clip(int &x, int &y, int &w, int &h) const;
+
+    // iterate over damaged rects
+    int count() const { return _count; }
+    int x(int i) const { return _rects[i].x1; }
+    int y(int i) const { return _rects[i].y1; }
+    int w(int i) const { return _rects[i].x2 - _rects[i].x1; }
+    int h(int i) const { return _rects[i].y2 - _rects[i].y1; }
+
+private:
+    // half-open, x2/y2 are exclusive
+    struct rect {
+        int x1, y1;
+        int x2, y2;
+    };
+
+    void add(rect r);
+    void remove(int i);
+
+    rect _rects[MAX_RECTS];
+    int _count;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stdint.h>
+#include <string.h>
+#include "fill.h"
+#include "blend.h"
+
+/**
+ * Pixel formats for Frame, one for each LCDC mode we drive
+ *
+ * Up to 8 bits pixels are palette indices, packed msb first, which is
+ * how the LCDC reads them in WinCE mode. 8-bit indices default to 3:3:2
+ * RGB. 16-bit pixels are 5:6:5 RGB and skip the palette.
+ *
+ * Each format knows how to get/put a single pixel and how to fill and
+ * copy rects with its own kernel, so Frame's drawing ops only fall back
+ * to pixel at a time where they have to. Positions are in pixels from
+ * the start of a row, strides are in bytes.
+ *
+ * blend draws a pixel with coverage a out of 255 for anti-aliasing, lut
+ * is blend_table(), fetched once per primitive. Only 3:3:2 can blend,
+ * everything else rounds coverage to on or off.
+ */
+
+// 1, 2 or 4-bit palette indices
+template <int BITS>
+struct FormatIndexed {
+    static const int BPP = BITS;
+    typedef uint8_t pixel_t;
+
+    static pixel_t get(const uint8_t *row, int x) {
+        int shift = 8 - BPP*(x % (8/BPP) + 1);
+        return (row[x / (8/BPP)] >> shift) & ((1 << BPP) - 1);
+    }
+
+    static void put(uint8_t *row, int x, pixel_t p) {
+        int shift = 8 - BPP*(x % (8/BPP) + 1);
+        uint8_t m = ((1 << BPP) - 1) << shift;
+        uint8_t *b = &row[x / (8/BPP)];
+        *b = (*b & ~m) | ((p << shift) & m);
+    }
+
+    static void fill(uint8_t *row, int stride, int x, int w, int h,
+            pixel_t p) {
+        fillrectbits(row, stride, BPP*x, BPP*w, h, pattern(p));
+    }
+
+    static void copy(uint8_t *dst, const uint8_t *src, int stride,
+            int x, int w, int h) {
+        copyrectbits(dst, src, stride, BPP*x, BPP*w, h);
+    }
+
+    static void blend(uint8_t *row, int x, pixel_t p, int a,
+            const uint8_t *lut) {
+        if (a >= 128) {
+            put(row, x, p);
+        }
+    }
+
+    // the pixel repeated across a byte
+    static uint8_t pattern(pixel_t p) {
+        p &= (1 << BPP) - 1;
+        for (int i = BPP; i < 8; i *= 2) {
+            p |= p << i;
+        }
+        return p;
+    }
+};
+
+typedef FormatIndexed<1> Format1;
+typedef FormatIndexed<2> Format2;
+typedef FormatIndexed<4> Format4;
+
+// 8-bit palette indices, 3:3:2 RGB with the default palette
+struct Format332 {
+    static const int BPP = 8;
+    typedef uint8_t pixel_t;
+
+    static pixel_t get(const uint8_t *row, int x) {
+        return row[x];
+    }
+
+    static void put(uint8_t *row, int x, pixel_t p) {
+        row[x] = p;
+    }
+
+    static void fill(uint8_t *row, int stride, int x, int w, int h,
+            pixel_t p) {
+        fillrect8(&row[x], stride, w, h, p);
+    }
+
+    static void copy(uint8_t *dst, const uint8_t *src, int stride,
+            int x, int w, int h) {
+        copyrect8(&dst[x], &src[x], stride, w, h);
+    }
+
+    static void blend(uint8_t *row, int x, pixel_t p, int a,
+            const uint8_t *lut) {
+        if (lut) {
+            row[x] = blend332(lut, p, row[x], a);
+        } else if (a >= 128) {
+            row[x] = p;
+        }
+    }
+};
+
+// 16-bit 5:6:5 RGB, red on top like the palette
+struct Format565 {
+    static const int BPP = 16;
+    typedef uint16_t pixel_t;
+
+    static pixel_t get(const uint8_t *row, int x) {
+        return ((const uint16_t*)row)[x];
+    }
+
+    static void put(uint8_t *row, int x, pixel_t p) {
+        ((uint16_t*)row)[x] = p;
+    }
+
+    static void fill(uint8_t *row, int stride, int x, int w, int h,
+            pixel_t p) {
+        fillrect16(&row[2*x], stride, w, h, p);
+    }
+
+    static void copy(uint8_t *dst, const uint8_t *src, int stride,
+            int x, int w, int h) {
+        copyrect8(&dst[2*x], &src[2*x], stride, 2*w, h);
+    }
+
+    static void blend(uint8_t *row, int x, pixel_t p, int a,
+            const uint8_t *lut) {
+        if (a >= 128) {
+            put(row, x, p);
+        }
+    }
+
+    static pixel_t rgb(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+    }
+};
+
+// true if A and B are the same format, for code that only handles some
+template <typename A, typename B>
+struct FormatSame {
+    static const bool value = false;
+};
+
+template <typename A>
+struct FormatSame<A, A> {
+    static const bool value = true;
+};
+
+#endif
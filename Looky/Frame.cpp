@@ -1,16 +1,138 @@
 #include "mbed.h"
 #include "Frame.h"
 #include "font.h"
+#include "fill.h"
+#include "image.h"
+#include "blend.h"
 #include "assert.h"
+#include <math.h>
 
 // general pixel-level stuff
-void Frame::putp(int x, int y, uint8_t p) const {
+template <typename F>
+void FrameT<F>::putp(int x, int y, pixel_t p) const {
+    if (inclip(x, y)) {
+        plot(x, y, p);
+    }
+}
+
+template <typename F>
+typename FrameT<F>::pixel_t FrameT<F>::getp(int x, int y) const {
     assert(x + y*_w < _w*_h);
-    ((uint8_t*)_frame)[transform(x, y)] = p;
+    return F::get(row(y), transformx(x));
+}
+
+// font stuff for printing, font is encoded as a nibble per glyph row,
+// which we expand into a word of pixels with this table. Pixel 0 is the
+// lowest byte, so this assumes little-endian (we're a Cortex-M)
+static const uint32_t glyph_masks[16] = {
+    0x00000000, 0x000000ff, 0x0000ff00, 0x0000ffff,
+    0x00ff0000, 0x00ff00ff, 0x00ffff00, 0x00ffffff,
+    0xff000000, 0xff0000ff, 0xff00ff00, 0xff00ffff,
+    0xffff0000, 0xffff00ff, 0xffffff00, 0xffffffff,
+};
+
+// glyphs aren't aligned, M4 is fine with unaligned words and memcpy
+// compiles down to a single ldr/str
+static inline uint32_t load32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void store32(uint8_t *p, uint32_t v) {
+    memcpy(p, &v, sizeof(v));
 }
 
-// font stuff for printing, font is encoded as bit-per-pixel
-void Frame::putc(int x, int y, int c, uint8_t p) const {
+// clipping, these run once per primitive
+template <typename F>
+bool FrameT<F>::cliprect(int &x, int &y, int &w, int &h) const {
+    int x1 = max(transformx(x), _cx1);
+    int y1 = max(transformy(y), _cy1);
+    int x2 = min(transformx(x) + w, _cx2);
+    int y2 = min(transformy(y) + h, _cy2);
+    if (x1 >= x2 || y1 >= y2) {
+        return false;
+    }
+
+    x = x1 - _x;
+    y = y1 - _y;
+    w = x2 - x1;
+    h = y2 - y1;
+    return true;
+}
+
+enum {
+    CLIP_LEFT   = 1,
+    CLIP_RIGHT  = 2,
+    CLIP_TOP    = 4,
+    CLIP_BOTTOM = 8,
+};
+
+static inline int outcode(int x, int y, int x1, int y1, int x2, int y2) {
+    return ((x < x1) ? CLIP_LEFT : (x > x2) ? CLIP_RIGHT  : 0) |
+           ((y < y1) ? CLIP_TOP  : (y > y2) ? CLIP_BOTTOM : 0);
+}
+
+// Cohen-Sutherland, outcodes tell us which edges an endpoint is past,
+// we slide endpoints onto the edges until both are in or both are past
+// the same edge. Lines can be long, so intersections are done in 64-bits
+template <typename F>
+bool FrameT<F>::clipline(int &x1, int &y1, int &x2, int &y2) const {
+    // inclusive clip rect in our coordinates
+    int cx1 = clipx();
+    int cy1 = clipy();
+    int cx2 = clipx() + clipw() - 1;
+    int cy2 = clipy() + cliph() - 1;
+    int c1 = outcode(x1, y1, cx1, cy1, cx2, cy2);
+    int c2 = outcode(x2, y2, cx1, cy1, cx2, cy2);
+
+    while (true) {
+        if (!(c1 | c2)) {
+            return true;
+        } else if (c1 & c2) {
+            return false;
+        }
+
+        // move whichever endpoint is outside
+        int c = c1 ? c1 : c2;
+        int64_t dx = (int64_t)x2 - x1;
+        int64_t dy = (int64_t)y2 - y1;
+        int x, y;
+        if (c & CLIP_TOP) {
+            y = cy1;
+            x = x1 + dx*(y - y1)/dy;
+        } else if (c & CLIP_BOTTOM) {
+            y = cy2;
+            x = x1 + dx*(y - y1)/dy;
+        } else if (c & CLIP_LEFT) {
+            x = cx1;
+            y = y1 + dy*(x - x1)/dx;
+        } else {
+            x = cx2;
+            y = y1 + dy*(x - x1)/dx;
+        }
+
+        if (c == c1) {
+            x1 = x;
+            y1 = y;
+            c1 = outcode(x1, y1, cx1, cy1, cx2, cy2);
+        } else {
+            x2 = x;
+            y2 = y;
+            c2 = outcode(x2, y2, cx1, cy1, cx2, cy2);
+        }
+    }
+}
+
+template <typename F>
+static inline bool glyphfits(const FrameT<F> &f, int x, int y) {
+    return x >= f.clipx() && x + FONT_WIDTH  <= f.clipx() + f.clipw() &&
+           y >= f.clipy() && y + FONT_HEIGHT <= f.clipy() + f.cliph();
+}
+
+// any format, a pixel at a time
+template <typename F>
+void FrameT<F>::putc(int x, int y, int c, pixel_t p) const {
     c -= ' ';
     for (int i = 0; i < FONT_WIDTH; i++) {
         for (int j = 0; j < FONT_HEIGHT; j++) {
@@ -21,69 +143,394 @@ void Frame::putc(int x, int y, int c, uint8_t p) const {
     }
 }
 
-void Frame::puts(int x, int y, const char *s, uint8_t p) const {
+template <typename F>
+void FrameT<F>::putc(int x, int y, int c, pixel_t p, pixel_t bg) const {
+    c -= ' ';
+    for (int i = 0; i < FONT_WIDTH; i++) {
+        for (int j = 0; j < FONT_HEIGHT; j++) {
+            putp(x+i, y+j, ((font[c*FONT_WIDTH + i] >> j) & 1) ? p : bg);
+        }
+    }
+}
+
+// 8-bit glyphs are a word per row
+template <>
+void FrameT<Format332>::putc(int x, int y, int c, uint8_t p) const {
+    c -= ' ';
+    if (!glyphfits(*this, x, y)) {
+        // slow path for glyphs hanging off the edge
+        for (int i = 0; i < FONT_WIDTH; i++) {
+            for (int j = 0; j < FONT_HEIGHT; j++) {
+                if ((font[c*FONT_WIDTH + i] >> j) & 1) {
+                    putp(x+i, y+j, p);
+                }
+            }
+        }
+        return;
+    }
+
+    uint32_t rows = font_rows[c];
+    uint32_t p32 = 0x01010101u * p;
+    uint8_t *d = &((uint8_t*)_frame)[transform(x, y)];
+    for (int j = 0; j < FONT_HEIGHT; j++) {
+        uint32_t m = glyph_masks[(rows >> 4*j) & 0xf];
+        if (m) {
+            store32(d, (load32(d) & ~m) | (p32 & m));
+        }
+        d += _fwidth;
+    }
+}
+
+template <>
+void FrameT<Format332>::putc(int x, int y, int c,
+        uint8_t p, uint8_t bg) const {
+    c -= ' ';
+    if (!glyphfits(*this, x, y)) {
+        // slow path for glyphs hanging off the edge
+        for (int i = 0; i < FONT_WIDTH; i++) {
+            for (int j = 0; j < FONT_HEIGHT; j++) {
+                putp(x+i, y+j, ((font[c*FONT_WIDTH + i] >> j) & 1)
+                        ? p : bg);
+            }
+        }
+        return;
+    }
+
+    uint32_t rows = font_rows[c];
+    uint32_t p32 = 0x01010101u * p;
+    uint32_t bg32 = 0x01010101u * bg;
+    uint8_t *d = &((uint8_t*)_frame)[transform(x, y)];
+    for (int j = 0; j < FONT_HEIGHT; j++) {
+        uint32_t m = glyph_masks[(rows >> 4*j) & 0xf];
+        store32(d, (p32 & m) | (bg32 & ~m));
+        d += _fwidth;
+    }
+}
+
+template <typename F>
+void FrameT<F>::puts(int x, int y, const char *s, pixel_t p) const {
     for (; *s; s++) {
         putc(x, y, *s, p);
         x += FONT_WIDTH;
     }
 }
 
-// incremental error algorithm for rasterizing a line
-void Frame::putline(int x1, int y1, int x2, int y2, uint8_t p) const {
+template <typename F>
+void FrameT<F>::puts(int x, int y, const char *s,
+        pixel_t p, pixel_t bg) const {
+    for (; *s; s++) {
+        putc(x, y, *s, p, bg);
+        x += FONT_WIDTH;
+    }
+}
+
+// incremental error algorithm for rasterizing a line, clipped up front
+// so the inner loops don't need to check anything, and walking a pointer
+// through the frame buffer so we never recompute an address
+template <typename F>
+void FrameT<F>::putline(int x1, int y1, int x2, int y2, pixel_t p) const {
+    if (!clipline(x1, y1, x2, y2)) {
+        return;
+    }
+
     int dx = (x1 < x2) ? x2-x1 : x1-x2;
     int dy = (y1 < y2) ? y2-y1 : y1-y2;
     int sx = (x1 < x2) ? 1 : -1;
     int sy = (y1 < y2) ? 1 : -1;
-    int err = dx - dy;
 
-    while (true) {
-        putp(x1, y1, p);
+    // horizontal lines are just a span
+    if (dy == 0) {
+        F::fill(row(y1), stride(), transformx(min(x1, x2)), dx+1, 1, p);
+        return;
+    }
 
-        int err2 = 2*err;
+    // 8-bit and up steps a byte pointer, sub-byte pixels step a row
+    // pointer and a pixel index into it, the unused steps are constant
+    // zeros per format, so the compiler drops them
+    uint8_t *d = row(y1);
+    int x = transformx(x1);
+    if (BPP >= 8) {
+        d += x*(BPP/8);
+        x = 0;
+    }
+    int xstep = (BPP >= 8) ? 0 : sx;
+    int dstep = (BPP >= 8) ? sx*(BPP/8) : 0;
+    int ystep = sy*stride();
 
-        if (x1 == x2 && y1 == y2) {
-            break;
+    // vertical lines only step rows
+    if (dx == 0) {
+        for (int i = 0; i <= dy; i++) {
+            F::put(d, x, p);
+            d += ystep;
         }
+        return;
+    }
 
-        if (err2 > -dy) {
+    // the major axis steps every pixel, the minor axis when the error
+    // says so, same pixels as stepping both axes by error
+    int err = dx - dy;
+    if (dx >= dy) {
+        for (int i = 0; i < dx; i++) {
+            F::put(d, x, p);
+            int err2 = 2*err;
             err -= dy;
-            x1 += sx;
+            d += dstep;
+            x += xstep;
+            if (err2 < dx) {
+                err += dx;
+                d += ystep;
+            }
+        }
+    } else {
+        for (int i = 0; i < dy; i++) {
+            F::put(d, x, p);
+            int err2 = 2*err;
+            if (err2 > -dy) {
+                err -= dy;
+                d += dstep;
+                x += xstep;
+            }
+            err += dx;
+            d += ystep;
+        }
+    }
+
+    F::put(d, x, p);
+}
+
+// Wu's anti-aliased lines, we walk the major axis with the minor axis
+// in 16.16 fixed point, and split coverage between the two pixels the
+// line falls between. Clipping the major axis up front doesn't change
+// the slope, so we do that, the minor axis is checked per pixel
+template <typename F>
+void FrameT<F>::putaaline(int x1, int y1, int x2, int y2,
+        pixel_t p) const {
+    // pixel stores can alias us, so keep what we need in locals
+    const uint8_t *lut = blend_table();
+    int ox = transformx(0);
+    int step = stride();
+    int dx = (x1 < x2) ? x2-x1 : x1-x2;
+    int dy = (y1 < y2) ? y2-y1 : y1-y2;
+
+    if (dx >= dy) {
+        if (x1 > x2) {
+            int t;
+            t = x1; x1 = x2; x2 = t;
+            t = y1; y1 = y2; y2 = t;
         }
 
-        if (x1 == x2 && y1 == y2) {
-            break;
+        int s1 = max(x1, clipx());
+        int s2 = min(x2, clipx()+clipw()-1);
+        if (s1 > s2) {
+            return;
         }
 
-        if (err2 < dx) {
-            err += dx;
-            y1 += sy;
+        // round the gradient so we land on the far endpoint
+        int64_t g = dx ? (((int64_t)(y2-y1)*65536)
+                + ((y2 >= y1) ? dx/2 : -dx/2)) / dx : 0;
+        int64_t v = ((int64_t)y1*65536) + g*(s1-x1);
+        int cy1 = clipy();
+        int cy2 = clipy()+cliph()-1;
+        int ry = (int)(v >> 16);
+        uint8_t *r = row(ry);
+        for (int x = s1; x <= s2; x++) {
+            int y = (int)(v >> 16);
+            int a = (int)(v >> 8) & 0xff;
+            if (y != ry) {
+                r += (y-ry)*step;
+                ry = y;
+            }
+
+            if (y >= cy1 && y <= cy2) {
+                F::blend(r, ox+x, p, 255-a, lut);
+            }
+            if (y+1 >= cy1 && y+1 <= cy2) {
+                F::blend(r+step, ox+x, p, a, lut);
+            }
+            v += g;
+        }
+    } else {
+        if (y1 > y2) {
+            int t;
+            t = x1; x1 = x2; x2 = t;
+            t = y1; y1 = y2; y2 = t;
+        }
+
+        int s1 = max(y1, clipy());
+        int s2 = min(y2, clipy()+cliph()-1);
+        if (s1 > s2) {
+            return;
+        }
+
+        int64_t g = (((int64_t)(x2-x1)*65536)
+                + ((x2 >= x1) ? dy/2 : -dy/2)) / dy;
+        int64_t v = ((int64_t)x1*65536) + g*(s1-y1);
+        int cx1 = clipx();
+        int cx2 = clipx()+clipw()-1;
+        uint8_t *r = row(s1);
+        for (int y = s1; y <= s2; y++) {
+            int x = (int)(v >> 16);
+            int a = (int)(v >> 8) & 0xff;
+            if (x >= cx1 && x <= cx2) {
+                F::blend(r, ox+x, p, 255-a, lut);
+            }
+            if (x+1 >= cx1 && x+1 <= cx2) {
+                F::blend(r, ox+x+1, p, a, lut);
+            }
+            r += step;
+            v += g;
+        }
+    }
+}
+
+// anti-aliased circles, coverage comes from each pixel's distance to
+// the edge, which we only work out for pixels near the edge. Rows are
+// clipped up front, pixels in them are checked. Circles are a pixel
+// wide, coverage falls off over a pixel either side of the radius
+template <typename F>
+void FrameT<F>::putaacircle(int x, int y, int r, pixel_t p) const {
+    if (r < 0) {
+        return;
+    }
+
+    const uint8_t *lut = blend_table();
+    int j1 = max(-r-1, clipy()-y);
+    int j2 = min(r+1, clipy()+cliph()-1-y);
+    for (int j = j1; j <= j2; j++) {
+        int jj = j*j;
+        int inner2 = (r-1)*(r-1) - jj;
+        int i1 = (r > 0 && inner2 > 0) ? (int)sqrtf((float)inner2) : 0;
+        int i2 = (int)sqrtf((float)((r+1)*(r+1) - jj));
+        for (int i = i1; i <= i2; i++) {
+            float d = sqrtf((float)(i*i + jj));
+            int a = (int)(255.0f*(1.0f - fabsf(d - (float)r)));
+            if (a <= 0) {
+                continue;
+            }
+
+            blendp(x+i, y+j, p, a, lut);
+            if (i) {
+                blendp(x-i, y+j, p, a, lut);
+            }
         }
     }
+}
+
+// filled circles, solid out to half a pixel inside the radius, which
+// is a span per row, then blended out to half a pixel past it
+template <typename F>
+void FrameT<F>::putaadisc(int x, int y, int r, pixel_t p) const {
+    if (r < 0) {
+        return;
+    }
+
+    const uint8_t *lut = blend_table();
+    float in = (float)r - 0.5f;
+    float out = (float)r + 0.5f;
+    int j1 = max(-r, clipy()-y);
+    int j2 = min(r, clipy()+cliph()-1-y);
+    for (int j = j1; j <= j2; j++) {
+        int jj = j*j;
+        float solid2 = in*in - (float)jj;
+        int solid = (in > 0 && solid2 >= 0) ? (int)sqrtf(solid2) : -1;
+        int i2 = (int)sqrtf(out*out - (float)jj);
+        if (solid >= 0) {
+            putrect(x-solid, y+j, 2*solid+1, 1, p);
+        }
+
+        for (int i = solid+1; i <= i2; i++) {
+            float d = sqrtf((float)(i*i + jj));
+            int a = (int)(255.0f*(out - d));
+            if (a <= 0) {
+                continue;
+            }
 
-    putp(x2, y2, p);
+            a = min(a, 255);
+            blendp(x+i, y+j, p, a, lut);
+            if (i) {
+                blendp(x-i, y+j, p, a, lut);
+            }
+        }
+    }
 }
 
-// color rect in strips
-void Frame::putrect(int x1, int y1, int dx, int dy, uint8_t p) const {
-    for (int i = 0; i < dy; i++) {
-        memset(&((uint8_t*)_frame)[transform(x1, y1+i)], p, dx);
+// color rect in strips, rows share alignment so this is word-wide
+template <typename F>
+void FrameT<F>::putrect(int x1, int y1, int dx, int dy, pixel_t p) const {
+    if (!cliprect(x1, y1, dx, dy)) {
+        return;
     }
+
+    F::fill(row(y1), stride(), transformx(x1), dx, dy, p);
 }
 
-void Frame::putbuffer(int x1, int y1, int dx, int dy, void *ps) const {
+template <typename F>
+void FrameT<F>::putbuffer(int x1, int y1, int dx, int dy, void *ps) const {
+    // clip, keeping track of where that puts us in the buffer
+    int bytes = (dx*BPP + 7) / 8;
+    int cx = x1, cy = y1;
+    if (!cliprect(cx, cy, dx, dy)) {
+        return;
+    }
+
+    int sx = cx - x1;
+    int sy = cy - y1;
     for (int i = 0; i < dy; i++) {
-        memcpy(&((uint8_t*)_frame)[transform(x1, y1+i)],
-                &((uint8_t*)ps)[i*dx], dx);
+        const uint8_t *src = &((const uint8_t*)ps)[(sy+i)*bytes];
+        if (BPP >= 8) {
+            memcpy(buffer(cx, cy+i), &src[sx*BPP/8], dx*BPP/8);
+        } else {
+            for (int j = 0; j < dx; j++) {
+                plot(cx+j, cy+i, F::get(src, sx+j));
+            }
+        }
     }
 }
 
-// color entire frame, this is _slightly_ faster
-void Frame::clear(uint8_t p) const {
-    if (_w == _fwidth) {
-        // fast if we're not a slice
-        memset(_frame, p, _w*_h);
+template <typename F>
+void FrameT<F>::putframe(const FrameT &f, int x1, int y1,
+        int dx, int dy) const {
+    if (!cliprect(x1, y1, dx, dy)) {
+        return;
+    }
+
+    F::copy(row(y1), f.row(y1), stride(), transformx(x1), dx, dy);
+}
+
+// the decoder writes 3:3:2 bytes
+template <typename F>
+int FrameT<F>::putimage(int x1, int y1, const void *img, size_t size) const {
+    return -1;
+}
+
+template <>
+int FrameT<Format332>::putimage(int x1, int y1,
+        const void *img, size_t size) const {
+    // the part of the image that lands in our clip rect, the decoder
+    // clips this to the image
+    int sx = (x1 < clipx()) ? clipx()-x1 : 0;
+    int sy = (y1 < clipy()) ? clipy()-y1 : 0;
+    return image_decoderect(buffer(x1+sx, y1+sy), stride(),
+            sx, sy,
+            clipx()+clipw() - (x1+sx), clipy()+cliph() - (y1+sy),
+            (const uint8_t*)img, size);
+}
+
+// color entire clip rect, this is _slightly_ faster
+template <typename F>
+void FrameT<F>::clear(pixel_t p) const {
+    if (clipw() == _fwidth) {
+        // fast if we're clipped to full rows, rows are one span
+        F::fill(row(clipy()), stride()*cliph(), 0,
+                clipw()*cliph(), 1, p);
     } else {
         // fallback to putrect
-        putrect(0, 0, _w, _h, p);
+        putrect(clipx(), clipy(), clipw(), cliph(), p);
     }
 }
+
+template class FrameT<Format1>;
+template class FrameT<Format2>;
+template class FrameT<Format4>;
+template class FrameT<Format332>;
+template class FrameT<Format565>;
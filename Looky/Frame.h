@@ -1,62 +1,115 @@
 #ifndef FRAME_H
 #define FRAME_H
 
+#include "Format.h"
+
 /**
  * General purpose frame class for rendering stuff
  *
  * x/y coordinates up to 32-bits
- * color values are 8-bits, 3:3:2 RGB encoding
+ * pixels are whatever the format says, see Format.h, Frame itself is
+ * the one LookyTouchy drives the LCD with, 8-bit 3:3:2 by default
  */
-class Frame {
+template <typename F>
+class FrameT {
 public:
+    typedef F format_t;
+    typedef typename F::pixel_t pixel_t;
+    static const int BPP = F::BPP;
+
     // constructors (supports slicing!), always weak references
     // ain't got no mem for nuthin else
-    Frame(int w, int h)
+    FrameT(int w, int h)
             : _frame(NULL)
             , _fwidth(0)
             , _x(0)
             , _y(0)
             , _w(w)
-            , _h(h) {}
-    Frame(int x, int y, int w, int h)
+            , _h(h)
+            , _cx1(0)
+            , _cy1(0)
+            , _cx2(w)
+            , _cy2(h) {}
+    FrameT(int x, int y, int w, int h)
             : _frame(NULL)
             , _fwidth(0)
             , _x(x)
             , _y(y)
             , _w(w)
-            , _h(h) {}
-    Frame(uint64_t *frame, int w, int h)
+            , _h(h)
+            , _cx1(x)
+            , _cy1(y)
+            , _cx2(x+w)
+            , _cy2(y+h) {}
+    FrameT(uint64_t *frame, int w, int h)
             : _frame(frame)
             , _fwidth(w)
             , _x(0)
             , _y(0)
             , _w(w)
-            , _h(h) {}
-    Frame(const Frame &f)
+            , _h(h)
+            , _cx1(0)
+            , _cy1(0)
+            , _cx2(w)
+            , _cy2(h) {}
+    FrameT(const FrameT &f)
             : _frame(f._frame)
             , _fwidth(f._fwidth)
             , _x(f._x)
             , _y(f._y)
             , _w(f._w)
-            , _h(f._h) {}
-    Frame(const Frame &f, int x, int y, int w, int h)
+            , _h(f._h)
+            , _cx1(f._cx1)
+            , _cy1(f._cy1)
+            , _cx2(f._cx2)
+            , _cy2(f._cy2) {}
+    // slices are clipped to their parent's clip rect
+    FrameT(const FrameT &f, int x, int y, int w, int h)
             : _frame(f._frame)
-            , _fwidth(f._w)
+            , _fwidth(f._fwidth)
             , _x(f._x + x)
             , _y(f._y + y)
             , _w(w)
-            , _h(h) {}
+            , _h(h)
+            , _cx1(f._cx1)
+            , _cy1(f._cy1)
+            , _cx2(f._cx2)
+            , _cy2(f._cy2) {
+        setclip(0, 0, w, h);
+    }
 
-    // drawing operations
-    void putp(int x, int y, uint8_t p) const;
-    void putc(int x, int y, int c, uint8_t p=0xff) const;
-    void puts(int x, int y, const char *s, uint8_t p=0xff) const;
+    // drawing operations, these only touch pixels inside the clip rect,
+    // which is clipped once per primitive, not per pixel
+    void putp(int x, int y, pixel_t p) const;
+    pixel_t getp(int x, int y) const;
+    void putc(int x, int y, int c, pixel_t p=0xff) const;
+    void puts(int x, int y, const char *s, pixel_t p=0xff) const;
 
-    void putline(int x1, int y1, int x2, int y2, uint8_t p=0xff) const;
-    void putrect(int x1, int y1, int dx, int dy, uint8_t p=0xff) const;
+    // same thing but with an opaque background, this is a pure store
+    // so prefer it when you know what's behind the text
+    void putc(int x, int y, int c, pixel_t p, pixel_t bg) const;
+    void puts(int x, int y, const char *s, pixel_t p, pixel_t bg) const;
+
+    void putline(int x1, int y1, int x2, int y2, pixel_t p=0xff) const;
+    void putrect(int x1, int y1, int dx, int dy, pixel_t p=0xff) const;
+
+    // anti-aliased lines and circles, edges are blended into whatever is
+    // already there with blend_table(), see blend.h, discs are filled
+    void putaaline(int x1, int y1, int x2, int y2, pixel_t p=0xff) const;
+    void putaacircle(int x, int y, int r, pixel_t p=0xff) const;
+    void putaadisc(int x, int y, int r, pixel_t p=0xff) const;
+
+    // ps is dx x dy pixels in our format, rows padded to a byte
     void putbuffer(int x1, int y1, int dx, int dy, void *ps) const;
 
-    void clear(uint8_t p=0) const;
+    // copy a rect from the same place in another frame with our stride
+    void putframe(const FrameT &f, int x1, int y1, int dx, int dy) const;
+
+    // compressed images from image.h, these get clipped to the frame,
+    // returns -1 if the image is bad, only 8-bit frames for now
+    int putimage(int x1, int y1, const void *img, size_t size) const;
+
+    void clear(pixel_t p=0) const;
 
     // useful info
     int x() const { return _x; }
@@ -64,6 +117,42 @@ public:
     int w() const { return _w; }
     int h() const { return _h; }
 
+    // clip rect, in our coordinates, always inside the frame. setclip
+    // only ever shrinks it, so make a copy to clip temporarily
+    void setclip(int x, int y, int w, int h) {
+        _cx1 = max(_cx1, transformx(x));
+        _cy1 = max(_cy1, transformy(y));
+        _cx2 = min(_cx2, transformx(x) + w);
+        _cy2 = min(_cy2, transformy(y) + h);
+        _cx2 = max(_cx1, _cx2);
+        _cy2 = max(_cy1, _cy2);
+    }
+
+    int clipx() const { return _cx1 - _x; }
+    int clipy() const { return _cy1 - _y; }
+    int clipw() const { return _cx2 - _cx1; }
+    int cliph() const { return _cy2 - _cy1; }
+
+    bool inclip(int x, int y) const {
+        return transformx(x) >= _cx1 && transformx(x) < _cx2 &&
+               transformy(y) >= _cy1 && transformy(y) < _cy2;
+    }
+
+    // clip a rect to the clip rect, false if nothing is left
+    bool cliprect(int &x, int &y, int &w, int &h) const;
+
+    // clip a line to the clip rect with Cohen-Sutherland, endpoints
+    // are inclusive, false if nothing is left
+    bool clipline(int &x1, int &y1, int &x2, int &y2) const;
+
+    // raw access to the underlying frame buffer, rows are stride()
+    // bytes apart, with sub-byte pixels this is the byte x is in
+    uint8_t *buffer(int x=0, int y=0) const {
+        return &((uint8_t*)_frame)[transform(x, y)*BPP/8];
+    }
+
+    int stride() const { return _fwidth*BPP/8; }
+
     // bounds checks + transformations
     bool inbounds(int x, int y) const {
         return x >= _x && x < (_x+_w) &&
@@ -78,7 +167,7 @@ public:
     }
 
     // modification to the internal frame buffer
-    void setframebuffer(const Frame &f) {
+    void setframebuffer(const FrameT &f) {
         _frame = f._frame;
         _fwidth = f._fwidth;
     }
@@ -90,6 +179,41 @@ private:
     int _y;
     int _w;
     int _h;
+
+    // clip rect, half-open, in frame buffer coordinates like _x/_y
+    int _cx1;
+    int _cy1;
+    int _cx2;
+    int _cy2;
+
+    static int min(int a, int b) { return (a < b) ? a : b; }
+    static int max(int a, int b) { return (a > b) ? a : b; }
+
+    // start of row y in the frame buffer
+    uint8_t *row(int y) const {
+        return &((uint8_t*)_frame)[transformy(y)*stride()];
+    }
+
+    // putp without the clipping, for primitives that already clipped
+    void plot(int x, int y, pixel_t p) const {
+        F::put(row(y), transformx(x), p);
+    }
+
+    // blend a pixel with coverage a out of 255, with clipping
+    void blendp(int x, int y, pixel_t p, int a, const uint8_t *lut) const {
+        if (inclip(x, y)) {
+            F::blend(row(y), transformx(x), p, a, lut);
+        }
+    }
 };
 
+// the frame format LookyTouchy runs the LCD in, override for low-bpp UI
+// screens or RGB565, the demo thingies in main and Playback write 3:3:2
+// bytes directly and won't build with anything else
+#ifndef LOOKY_FORMAT
+#define LOOKY_FORMAT Format332
+#endif
+
+typedef FrameT<LOOKY_FORMAT> Frame;
+
 #endif
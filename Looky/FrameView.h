@@ -0,0 +1,159 @@
+#ifndef FRAME_VIEW_H
+#define FRAME_VIEW_H
+
+#include "Frame.h"
+#include <assert.h>
+
+/**
+ * Bounds policies for FrameView, picked at compile time
+ *
+ * check returns true if the pixel at x/y in a w x h rect should be drawn
+ * - FrameChecked asserts the pixel is in the frame's clip rect
+ * - FrameClipped quietly drops pixels outside the clip rect, like Frame
+ * - FrameUnchecked trusts the caller, no overhead at all
+ *
+ * Lines are clipped once up front like Frame's, only FrameChecked checks
+ * them per pixel, so it can assert on lines that leave the clip rect.
+ */
+struct FrameChecked {
+    static const bool PER_PIXEL = true;
+
+    static bool check(int x, int y, int w, int h) {
+        assert((unsigned)x < (unsigned)w && (unsigned)y < (unsigned)h);
+        return true;
+    }
+};
+
+struct FrameClipped {
+    static const bool PER_PIXEL = false;
+
+    static bool check(int x, int y, int w, int h) {
+        return (unsigned)x < (unsigned)w && (unsigned)y < (unsigned)h;
+    }
+};
+
+struct FrameUnchecked {
+    static const bool PER_PIXEL = false;
+
+    static bool check(int, int, int, int) {
+        return true;
+    }
+};
+
+// default policy, asserts in debug builds, nothing in release
+#ifndef LOOKY_FRAME_POLICY
+#ifdef NDEBUG
+#define LOOKY_FRAME_POLICY FrameUnchecked
+#else
+#define LOOKY_FRAME_POLICY FrameChecked
+#endif
+#endif
+
+/**
+ * Fast view of a Frame for hot per-pixel loops
+ *
+ * The full frame buffer is W x H pixels, fixed at compile time, so row
+ * offsets are a multiply by a constant (shifts and adds) instead of a
+ * load and multiply by the frame's width. Coordinates are relative to
+ * the Frame the view was made from, like Frame, with the Frame's clip
+ * rect handled by the policy P. Views are weak references, make them on
+ * the stack in look/touch, they're just the Frame and a few ints.
+ */
+template <typename F, int W, int H, typename P=LOOKY_FRAME_POLICY>
+class FrameView {
+public:
+    typedef F format_t;
+    typedef typename F::pixel_t pixel_t;
+    typedef P policy_t;
+    static const int BPP = F::BPP;
+    static const int WIDTH = W;
+    static const int HEIGHT = H;
+    static const int STRIDE = W*F::BPP/8;
+
+    FrameView(const FrameT<F> &f)
+            : _frame(f)
+            , _row(f.buffer(-f.x(), 0))
+            , _x(f.x())
+            , _w(f.w())
+            , _h(f.h())
+            , _cx(f.clipx())
+            , _cy(f.clipy())
+            , _cw(f.clipw())
+            , _ch(f.cliph()) {
+        assert(f.stride() == STRIDE);
+        assert(f.x() + f.w() <= W && f.y() + f.h() <= H);
+    }
+
+    // drawing operations
+    void putp(int x, int y, pixel_t p) const {
+        if (P::check(x-_cx, y-_cy, _cw, _ch)) {
+            F::put(&_row[y*STRIDE], _x + x, p);
+        }
+    }
+
+    pixel_t getp(int x, int y) const {
+        if (P::check(x-_cx, y-_cy, _cw, _ch)) {
+            return F::get(&_row[y*STRIDE], _x + x);
+        }
+        return 0;
+    }
+
+    // Frame's rasterizer clips once and steps a pointer, with per-pixel
+    // checks we walk the same pixels through our putp instead
+    void putline(int x1, int y1, int x2, int y2, pixel_t p) const {
+        if (!P::PER_PIXEL) {
+            _frame.putline(x1, y1, x2, y2, p);
+            return;
+        }
+
+        int dx = (x1 < x2) ? x2-x1 : x1-x2;
+        int dy = (y1 < y2) ? y2-y1 : y1-y2;
+        int sx = (x1 < x2) ? 1 : -1;
+        int sy = (y1 < y2) ? 1 : -1;
+        int err = dx - dy;
+
+        while (true) {
+            putp(x1, y1, p);
+
+            if (x1 == x2 && y1 == y2) {
+                break;
+            }
+
+            int err2 = 2*err;
+            if (err2 > -dy) {
+                err -= dy;
+                x1 += sx;
+            }
+
+            if (err2 < dx) {
+                err += dx;
+                y1 += sy;
+            }
+        }
+    }
+
+    // useful info
+    int w() const { return _w; }
+    int h() const { return _h; }
+
+    // raw access, same as Frame::buffer, rows are STRIDE bytes apart
+    uint8_t *buffer(int x=0, int y=0) const {
+        return &_row[y*STRIDE + (_x + x)*BPP/8];
+    }
+
+    static int stride() { return STRIDE; }
+
+private:
+    FrameT<F> _frame;
+    // row 0 of the view, at column 0 of the frame buffer
+    uint8_t *_row;
+    int _x;
+    int _w;
+    int _h;
+    int _cx;
+    int _cy;
+    int _cw;
+    int _ch;
+};
+
+#endif
@@ -12,6 +12,11 @@ public:
     GUIThingy(GUI *gui);
 
     virtual int h() const = 0;
+
+    // most GUI elements are static, redraw only on changes
+    virtual bool animated() const {
+        return false;
+    }
 };
 
 class GUI : public Thingy {
@@ -33,6 +38,14 @@ public:
        f.putline(0, 0, 0, f.h()-1);
     }
 
+    virtual bool animated() const {
+        return false;
+    }
+
+    virtual const char *name() const {
+        return "gui";
+    }
+
     void add(GUIThingy *thingy) {
         _things.push_back(thingy);
     }
@@ -53,23 +66,28 @@ class GUILabel : public GUIThingy {
 public:
     GUILabel(GUI *gui, const char *s="")
         : GUIThingy(gui) {
-        _text = (char*)gui->_lt->alloc(256);
+        _text = (char*)gui->_lt->alloc(256, LOOKY_SRAM);
         strcpy(_text, s);
     }
 
     virtual void look(const Frame &f, int dt) {
-        f.puts(10, 0, _text);
+        f.puts(10, 0, _text, 0xff, 0x00);
     }
 
     virtual int h() const {
         return 11;
     }
 
+    virtual const char *name() const {
+        return "label";
+    }
+
     int printf(const char *fmt, ...) {
         va_list args;
         va_start(args, fmt);
         int res = vsprintf(_text, fmt, args);
         va_end(args);
+        invalidate();
         return res;
     }
 
@@ -86,6 +104,15 @@ public:
         this->printf("FPS: %d (%dms)", 1000/(dt|1), dt);
         GUILabel::look(f, dt);
     }
+
+    // changes every frame anyways
+    virtual bool animated() const {
+        return true;
+    }
+
+    virtual const char *name() const {
+        return "fps";
+    }
 };
 
 class GUIButton : public GUILabel {
@@ -109,6 +136,10 @@ public:
         bool prev = _on;
         _on = (x != -1);
 
+        if (prev != _on) {
+            invalidate();
+        }
+
         if (prev && !_on) {
             _cb();
         }
@@ -118,6 +149,10 @@ public:
         return 21;
     }
 
+    virtual const char *name() const {
+        return "button";
+    }
+
 private:
     bool _on;
     Callback<void()> _cb;
@@ -143,4 +178,158 @@ public:
     }
 };
 
+// Frame-time breakdown from LookyTouchy's profiler, avg and max in
+// microseconds, the whole frame, the priciest thingies, then the loop's
+// own sections as space allows
+class GUIProfile : public GUIThingy {
+public:
+    static const int MAX_LINES = 16;
+
+    GUIProfile(GUI *gui, int lines=12)
+        : GUIThingy(gui), _lt(gui->_lt), _seen(0)
+        , _lines(lines < MAX_LINES ? lines : MAX_LINES) {}
+
+    // only redraw when a new window of stats comes in
+    virtual bool animated() const {
+        return _lt->profile().windows() != _seen;
+    }
+
+    virtual void look(const Frame &f, int dt) {
+        const Profile &p = _lt->profile();
+        _seen = p.windows();
+
+        // the whole frame, then the priciest thingies in up to half of
+        // what's left, so they show up even when we're short on lines
+        int rows = _lines-1;
+        int shown[MAX_LINES-1];
+        int n = 0;
+        if (PROFILE_FRAME < p.count() && n < rows) {
+            shown[n++] = PROFILE_FRAME;
+        }
+
+        int things = n + (rows-n+1)/2;
+        while (n < things) {
+            int best = -1;
+            for (int i = PROFILE_THINGS; i < p.count(); i++) {
+                bool seen = false;
+                for (int j = 0; j < n; j++) {
+                    seen = seen || shown[j] == i;
+                }
+
+                if (!seen && (best < 0 ||
+                        p.stats(i).avg > p.stats(best).avg)) {
+                    best = i;
+                }
+            }
+
+            if (best < 0) {
+                break;
+            }
+            shown[n++] = best;
+        }
+
+        // then as much of the loop's own breakdown as fits
+        for (int i = PROFILE_FRAME+1; i < PROFILE_THINGS && i < p.count() &&
+                n < rows; i++) {
+            shown[n++] = i;
+        }
+
+        f.puts(10, 0, "us       avg   max", 0xff, 0x00);
+        for (int i = 0; i < n; i++) {
+            char line[32];
+            char index[8];
+            const char *name = p.name(shown[i]);
+            if (!name) {
+                sprintf(index, "#%d", shown[i] - PROFILE_THINGS);
+                name = index;
+            }
+
+            const Profile::Stats &stats = p.stats(shown[i]);
+            snprintf(line, sizeof(line), "%-7.7s%5u%6u", name,
+                    (unsigned)stats.avg, (unsigned)stats.max);
+            f.puts(10, 11*(i+1), line, 0xff, 0x00);
+        }
+    }
+
+    virtual int h() const {
+        return 11*_lines;
+    }
+
+    virtual const char *name() const {
+        return "profile";
+    }
+
+private:
+    LookyTouchy *_lt;
+    uint32_t _seen;
+    int _lines;
+};
+
+// Scrolling bar graph of the last SAMPLES values, scaled to the biggest,
+// with the latest printed on top. add is safe from other threads.
+class GUIGraph : public GUIThingy {
+public:
+    static const int SAMPLES = 80;
+
+    GUIGraph(GUI *gui, const char *label="", uint8_t color=0x1c)
+        : GUIThingy(gui), _label(label), _color(color)
+        , _count(0), _next(0) {}
+
+    // label is optional, and must stick around
+    void add(uint32_t value, const char *label=NULL) {
+        if (label) {
+            _label = label;
+        }
+
+        _values[_next] = value;
+        _next = (_next + 1) % SAMPLES;
+        _count += (_count < SAMPLES);
+        invalidate();
+    }
+
+    virtual void look(const Frame &f, int dt) {
+        int count = _count;
+        int next = _next;
+
+        uint32_t last = count ? _values[(next + SAMPLES-1) % SAMPLES] : 0;
+        char line[32];
+        snprintf(line, sizeof(line), "%-8.8s%7lu",
+                _label, (unsigned long)last);
+        f.puts(10, 0, line, 0xff, 0x00);
+
+        uint32_t max = 1;
+        for (int i = 0; i < count; i++) {
+            max = (_values[i] > max) ? _values[i] : max;
+        }
+
+        int h = f.h() - 12;
+        for (int i = 0; i < count; i++) {
+            uint32_t v = _values[(next + SAMPLES-count + i) % SAMPLES];
+            int bar = (int)((uint64_t)v*h / max);
+            if (bar > 0) {
+                f.putrect(10+i, f.h()-bar, 1, bar, _color);
+            }
+        }
+    }
+
+    virtual int h() const {
+        return 36;
+    }
+
+    virtual const char *name() const {
+        return "graph";
+    }
+
+    virtual bool animated() const {
+        return false;
+    }
+
+private:
+    const char *volatile _label;
+    uint8_t _color;
+    uint32_t _values[SAMPLES];
+    volatile int _count;
+    volatile int _next;
+};
+
 #endif
@@ -9,10 +9,14 @@
 #include "fsl_i2c.h"
 #include "board.h"
 #include "pin_mux.h"
-#include "image.h"
 #include "LookyTouchy.h"
 #include "font.h"
 #include "Frame.h"
+#include "fill.h"
+#include "blend.h"
+#include "Arena.h"
+#include "Palette.h"
+#include <new>
 
 // LCD stuff
 #define LCD_PANEL_CLK 9000000
@@ -25,31 +29,58 @@
 #define LCD_VFP 4
 #define LCD_VBP 12
 #define LCD_POL_FLAGS kLCDC_InvertVsyncPolarity | kLCDC_InvertHsyncPolarity
-#define LCD_HEIGHT 272
-#define LCD_WIDTH 480
 #define LCD_INPUT_CLK_FREQ CLOCK_GetFreq(kCLOCK_LCD)
 #define I2C_MASTER_CLOCK_FREQUENCY (12000000)
 #define I2C_BAUDRATE 100000U
 
 
-/// Allocator for SDRAM ///
+/// Allocators for SRAM/SDRAM ///
 #define SDRAM_ADDR 0xa0000000
 #define SDRAM_SIZE 0x01000000
-static       uint64_t *sdram_ptr = (uint64_t *)(SDRAM_ADDR);
-static const uint64_t *sdram_end = (uint64_t *)(SDRAM_ADDR+SDRAM_SIZE);
+
+// Internal SRAM we set aside for hot data, this comes out of .bss
+#ifndef LOOKY_SRAM_SIZE
+#define LOOKY_SRAM_SIZE (32*1024)
+#endif
+
+// Per-frame scratch space, reset at the top of every frame
+#ifndef LOOKY_SCRATCH_SIZE
+#define LOOKY_SCRATCH_SIZE (64*1024)
+#endif
+
+// Pools are arenas created on first use since LookyTouchy's constructor
+// may run before our static initializers.
+static Arena &sram() {
+    static uint64_t buffer[LOOKY_SRAM_SIZE/8];
+    static Arena arena("sram", buffer, sizeof(buffer));
+    return arena;
+}
+
+// The EMC maps SDRAM row-bank-column, so the bank bits sit just above
+// the column bits and consecutive rows' worth of addresses rotate
+// through all 4 banks, there's no range with a bank to itself
+static Arena &sdram() {
+    static Arena arena("sdram", (void*)SDRAM_ADDR, SDRAM_SIZE);
+    return arena;
+}
 
 // Allocate memory from the external SDRAM
 uint64_t *sdram_alloc(size_t size) {
-    // round up to nearest uint64_t
-    size = (size + (8 - 1)) / 8;
+    return (uint64_t*)sdram().alloc(size);
+}
+
+// Allocate with a placement hint, hints are only hints, if the preferred
+// pool is full we fall back to general SDRAM
+static void *looky_alloc(size_t size, int placement) {
+    void *p = 0;
+    if (placement == LOOKY_SRAM) {
+        p = sram().alloc(size);
+    }
 
-    // enough space?
-    if (size > (size_t)(sdram_end - sdram_ptr)) {
-        return 0;
+    if (!p) {
+        p = sdram_alloc(size);
     }
 
-    uint64_t *p = sdram_ptr;
-    sdram_ptr += size;
     return p;
 }
 
@@ -63,6 +94,12 @@ static EventFlags vsync;
 static Thread looky_thread;
 static Timer looky_timer;
 
+// palette is created on first use for the same reason as our pools
+static Palette &looky_palette() {
+    static Palette palette;
+    return palette;
+}
+
 /// Board-level initialization ///
 static status_t LookyTouchy_PWM_Init(void)
 {
@@ -95,18 +132,49 @@ extern "C" void LCD_IRQHandler(void)
 
     if (intStatus & kLCDC_VerticalCompareInterrupt) {
         vsync.set(1);
+
+        // load any palette changes while the panel is in its porch
+        const uint16_t *palette = looky_palette().vsync();
+        if (palette) {
+            LCDC_SetPalette(LCD, (const uint32_t*)palette, Palette::SIZE/2);
+        }
+
+        // kick off a touch read, this finishes in the I2C interrupt and
+        // the render loop just picks up the latest snapshot
+        FT5406_ReadTouchDataAsync(&touchy_handle);
     }
 
     __DSB();
 }
 
+// LCDC mode for each frame format
+static lcdc_bpp_t lcdc_bpp(Format1)   { return kLCDC_1BPP; }
+static lcdc_bpp_t lcdc_bpp(Format2)   { return kLCDC_2BPP; }
+static lcdc_bpp_t lcdc_bpp(Format4)   { return kLCDC_4BPP; }
+static lcdc_bpp_t lcdc_bpp(Format332) { return kLCDC_8BPP; }
+static lcdc_bpp_t lcdc_bpp(Format565) { return kLCDC_16BPP565; }
+
+// 3:3:2 frames get blend tables for anti-aliasing, other formats just
+// round coverage, see blend.h
+template <typename F>
+static void blend_setup(F) {}
+
+static void blend_setup(Format332) {
+    uint8_t *lut = (uint8_t*)looky_alloc(blend_size(), LOOKY_SDRAM);
+    if (lut) {
+        blend_init(lut);
+        blend_settable(lut);
+    }
+}
+
 status_t LookyTouchy_LCD_Init(void)
 {
     // Setup our internal frames to use SDRAM
     // We have two for double buffering, turns out writes are much
     // faster when memory is not in use by LCD (bus contention?)
-    frame_buffers[0] = sdram_alloc(LCD_WIDTH*LCD_HEIGHT);
-    frame_buffers[1] = sdram_alloc(LCD_WIDTH*LCD_HEIGHT);
+    // Lower bpp frames are smaller and cost less SDRAM bandwidth to scan
+    frame_buffers[0] = sdram_alloc(LCD_WIDTH*LCD_HEIGHT*Frame::BPP/8);
+    frame_buffers[1] = sdram_alloc(LCD_WIDTH*LCD_HEIGHT*Frame::BPP/8);
     assert(frame_buffers[0] && frame_buffers[1]);
 
     // Initialize the display.
@@ -122,24 +190,30 @@ status_t LookyTouchy_LCD_Init(void)
     lcdConfig.vfp = LCD_VFP;
     lcdConfig.vbp = LCD_VBP;
     lcdConfig.polarityFlags = LCD_POL_FLAGS;
-    lcdConfig.upperPanelAddr = (uint32_t)frame_buffers[0];
-    lcdConfig.bpp = kLCDC_8BPP;
+    lcdConfig.upperPanelAddr = (uint32_t)(uintptr_t)frame_buffers[0];
+    lcdConfig.bpp = lcdc_bpp(Frame::format_t());
     lcdConfig.display = kLCDC_DisplayTFT;
     lcdConfig.swapRedBlue = true;  //false;
     lcdConfig.dataFormat = kLCDC_WinCeMode;
     LCDC_Init(LCD, &lcdConfig, LCD_INPUT_CLK_FREQ);
 
-    // Generate 16-bit (5:6:5) RGB palette that maps 8-bit pixels (3:3:2) RGB
-    // Note these are backed in registers, we can free our local palette immediately
-    uint16_t *palette = (uint16_t*)malloc(256*sizeof(uint16_t));
-    for (int i = 0; i < 256; i++) {
-        palette[i] = (
-                (((((i & 0xe0) >> 5)* 9)/2) << 10) |
-                (((((i & 0x1c) >> 2)* 9)/2) <<  5) |
-                (((((i & 0x03) >> 0)*21)/2) <<  0));
+    // Low-bpp frames only index the bottom of the palette, so give them
+    // a gray ramp there instead of the darkest 3:3:2 colors
+    if (Frame::BPP < 8) {
+        int n = 1 << Frame::BPP;
+        for (int i = 0; i < n; i++) {
+            uint8_t v = 255*i / (n-1);
+            looky_palette().set(i, Palette::rgb(v, v, v));
+        }
+        looky_palette().commit();
     }
-    LCDC_SetPalette(LCD, (uint32_t*)palette, 256/2);
-    free(palette);
+
+    blend_setup(Frame::format_t());
+
+    // Load the default 3:3:2 palette, after this palette changes are
+    // loaded on vsync, 16-bit frames don't use it
+    LCDC_SetPalette(LCD, (const uint32_t*)looky_palette().vsync(),
+            Palette::SIZE/2);
 
     // Trigger interrupt at start of every vertical front porch.
     LCDC_SetVerticalInterruptMode(LCD, kLCDC_StartOfFrontPorch);
@@ -217,51 +291,172 @@ void LookyTouchy_Init() {
 
 LookyTouchy::LookyTouchy() {
     LookyTouchy_Init();
+    _scratch = arena("scratch", LOOKY_SCRATCH_SIZE);
+    assert(_scratch);
 }
 
 /// Main rendering thread ///
 void LookyTouchy::loop() {
+    // damage from the last frame, the other buffer hasn't seen it yet
+    Damage prev;
+    _touching.resize(_things.size());
+    uint32_t touchseq = 0;
+
+    _profile.resize(PROFILE_THINGS + _things.size());
+    _profile.name(PROFILE_FRAME,   "frame");
+    _profile.name(PROFILE_COPY,    "copy");
+    _profile.name(PROFILE_CLEAR,   "clear");
+    _profile.name(PROFILE_PALETTE, "palette");
+    _profile.name(PROFILE_TOUCH,   "touch");
+    _profile.name(PROFILE_VSYNC,   "vsync");
+    for (unsigned i = 0; i < _things.size(); i++) {
+        _profile.name(PROFILE_THINGS + i, _things[i]->name());
+    }
+
+    // both buffers start out as garbage
+    invalidate();
+
     int fi = 0;
     while (true) {
+        uint32_t start = Profile::now();
+        uint32_t t = start;
+
         // find time a frame takes
         int dt = looky_timer.read_ms();
         looky_timer.reset();
 
+        // anything in scratch was only good for last frame
+        _scratch->reset();
+
         // render a frame
         uint64_t *frame_buffer = frame_buffers[fi & 1];
+        uint64_t *front_buffer = frame_buffers[(fi+1) & 1];
         fi += 1;
 
         Frame f(frame_buffer, LCD_WIDTH, LCD_HEIGHT);
-        f.clear();
+        Frame front(front_buffer, LCD_WIDTH, LCD_HEIGHT);
+
+        // our back buffer was last shown two frames ago, copy forward
+        // whatever changed last frame so it holds the previous frame,
+        // this lets thingies draw on top of what they drew last time
+        for (int i = 0; i < prev.count(); i++) {
+            f.putframe(front, prev.x(i), prev.y(i), prev.w(i), prev.h(i));
+        }
+
+        t = _profile.lap(PROFILE_COPY, t);
+
+        // collect damage, persistent thingies don't want theirs cleared
+        Damage damage = _damage;
+        Damage clear = _damage;
+        _damage.clear();
+        for (unsigned i = 0; i < _frames.size(); i++) {
+            Damage d;
+            _things[i]->takedamage(_frames[i], d);
+            damage.add(d);
+            if (!_things[i]->persistent()) {
+                clear.add(d);
+            }
+        }
+
+        for (int i = 0; i < clear.count(); i++) {
+            Frame(f, clear.x(i), clear.y(i), clear.w(i), clear.h(i))
+                    .clear();
+        }
+
+        t = _profile.lap(PROFILE_CLEAR, t);
 
+        // redraw anything that touches the damage, clipped to the damage
+        // so nothing we aren't redrawing gets drawn over. A thingy
+        // spanning several rects is clipped to their bounds, which may
+        // poke out of the damage, so that becomes damage too and
+        // anything later on top of it gets redrawn there
         for (unsigned i = 0; i < _frames.size(); i++) {
+            int x = _frames[i].x();
+            int y = _frames[i].y();
+            int w = _frames[i].w();
+            int h = _frames[i].h();
+            if (!damage.clip(x, y, w, h)) {
+                continue;
+            }
+            damage.add(x, y, w, h);
+
             _frames[i].setframebuffer(f);
-            _things[i]->look(_frames[i], dt);
+            Frame clipped(_frames[i]);
+            clipped.setclip(x - clipped.x(), y - clipped.y(), w, h);
+            _things[i]->look(clipped, dt);
+            t = _profile.lap(PROFILE_THINGS + i, t);
         }
 
-        // begin frame update
-        LCDC_SetPanelAddr(LCD, kLCDC_UpperPanel, (uint32_t)frame_buffer);
+        prev = damage;
+
+        // begin frame update, palette changes go out with the frame
+        looky_palette().animate(dt);
+        looky_palette().commit();
+        t = _profile.lap(PROFILE_PALETTE, t);
+        LCDC_SetPanelAddr(LCD, kLCDC_UpperPanel,
+                (uint32_t)(uintptr_t)frame_buffer);
         vsync.clear(1);
 
-        // during frame update lets check for touch panel updates?
-        int tx, ty; // yes these are flipped!
-        touch_event_t touch_event;
-        status_t success = FT5406_GetSingleTouch(&touchy_handle, &touch_event, &ty, &tx);
-        if (success == kStatus_Success) {
-            for (unsigned i = 0; i < _frames.size(); i++) {
-                if (_frames[i].inbounds(tx, ty) &&
-                        (touch_event == kTouch_Down || touch_event == kTouch_Contact)) {
-                    _things[i]->touch(_frames[i],
-                            _frames[i].transformx(tx), _frames[i].transformy(ty));
-                } else {
-                    _things[i]->touch(_frames[i], -1, -1);
-                }
+        // during frame update lets check for touch panel updates, this
+        // is read asynchronously every vsync so we never wait on I2C
+        touch_point_t points[FT5406_MAX_TOUCHES];
+        int count;
+        uint32_t seq;
+        status_t success = FT5406_GetLatestMultiTouch(&touchy_handle,
+                &count, points, &seq);
+        if (success == kStatus_Success && seq != touchseq) {
+            touchseq = seq;
+
+            // yes these are flipped!
+            for (int i = 0; i < count; i++) {
+                uint16_t x = points[i].TOUCH_Y;
+                points[i].TOUCH_Y = points[i].TOUCH_X;
+                points[i].TOUCH_X = x;
             }
+
+            _touch.update(count, points);
+        }
+
+        TouchEvent e;
+        while (_touch.pop(&e)) {
+            dispatch(e);
         }
+        t = _profile.lap(PROFILE_TOUCH, t);
 
         // wait for vsync before continuing to next frame, this signals
         // our new buffer is actually on screen
         vsync.wait_all(1);
+        _profile.lap(PROFILE_VSYNC, t);
+        _profile.lap(PROFILE_FRAME, start);
+        _profile.frame();
+    }
+}
+
+// only thingies a contact is in, enters, or leaves hear about it
+void LookyTouchy::dispatch(const TouchEvent &e) {
+    uint16_t bit = 1 << e.id;
+
+    for (unsigned i = 0; i < _frames.size(); i++) {
+        bool inside = e.type != TOUCH_UP && _frames[i].inbounds(e.x, e.y);
+        bool was = _touching[i] & bit;
+        if (!inside && !was) {
+            continue;
+        }
+
+        // transform into thingy's coordinates
+        TouchEvent te = e;
+        te.x -= _frames[i].x();
+        te.y -= _frames[i].y();
+
+        if (inside) {
+            _touching[i] |= bit;
+            te.type = was ? TOUCH_MOVE : TOUCH_DOWN;
+        } else {
+            _touching[i] &= ~bit;
+            te.type = TOUCH_UP;
+        }
+
+        _things[i]->touchevent(_frames[i], te);
     }
 }
 
@@ -326,6 +521,19 @@ void LookyTouchy::add_touchy(int x, int y, int w, int h,
     add(x, y, w, h, new TouchyThingy(cb));
 }
 
+void LookyTouchy::invalidate() {
+    _damage.add(0, 0, LCD_WIDTH, LCD_HEIGHT);
+}
+
+void LookyTouchy::invalidate(int x, int y, int w, int h) {
+    // clip to the screen
+    int x2 = (x+w < LCD_WIDTH)  ? x+w : LCD_WIDTH;
+    int y2 = (y+h < LCD_HEIGHT) ? y+h : LCD_HEIGHT;
+    x = (x > 0) ? x : 0;
+    y = (y > 0) ? y : 0;
+    _damage.add(x, y, x2-x, y2-y);
+}
+
 int LookyTouchy::w() const {
     return LCD_WIDTH;
 }
@@ -334,6 +542,29 @@ int LookyTouchy::h() const {
     return LCD_HEIGHT;
 }
 
-void *LookyTouchy::alloc(size_t size) {
-    return sdram_alloc(size);
+void *LookyTouchy::alloc(size_t size, int placement) {
+    return looky_alloc(size, placement);
+}
+
+Arena *LookyTouchy::arena(const char *name, size_t size, int placement) {
+    // keep the arena itself next to its memory
+    void *a = looky_alloc(sizeof(Arena), placement);
+    void *buffer = looky_alloc(size, placement);
+    if (!a || !buffer) {
+        return NULL;
+    }
+
+    return new (a) Arena(name, buffer, size);
+}
+
+const Profile &LookyTouchy::profile() const {
+    return _profile;
+}
+
+Palette &LookyTouchy::palette() {
+    return looky_palette();
+}
+
+Arena &LookyTouchy::scratch() {
+    return *_scratch;
 }
@@ -2,11 +2,31 @@
 #define LOOKY_TOUCHY_H
 
 #include "Frame.h"
+#include "FrameView.h"
 #include "Thingy.h"
+#include "Damage.h"
+#include "Touch.h"
+#include "Arena.h"
+#include "Palette.h"
+#include "Profile.h"
 #include "Callback.h"
 #include "fsl_ft5406.h"
 #include <vector>
 
+// Memory placement hints for allocations
+enum {
+    LOOKY_SDRAM,            // bulk external SDRAM, the default
+    LOOKY_SRAM,             // small pool of fast internal SRAM
+};
+
+// LCD resolution, every Frame handed to a thingy is a slice of this
+#define LCD_WIDTH 480
+#define LCD_HEIGHT 272
+
+// Fast view of any Frame handed to a thingy, for hot per-pixel loops,
+// see FrameView.h
+typedef FrameView<Frame::format_t, LCD_WIDTH, LCD_HEIGHT> LCDView;
+
 class LookyTouchy {
 public:
     // Note we bring up a lot of board stuff in our constructor.
@@ -29,17 +49,49 @@ public:
     int w()  const;
     int h() const;
 
-    // Allocates chunks from SRAM (which is mostly used for video-RAM)
+    // Allocates chunks from SDRAM (which is mostly used for video-RAM),
+    // or from a small pool of internal SRAM with LOOKY_SRAM. Hot data
+    // should go in SRAM so it doesn't fight LCD scanout for the SDRAM bus.
     // note! one-time allocation! no free available. Always 64-bit aligned.
-    void *alloc(size_t size);
+    void *alloc(size_t size, int placement=LOOKY_SDRAM);
+
+    // Named arenas carved out of SDRAM (or SRAM), these can be rolled
+    // back or reset, see Arena.h. Returns NULL if we're out of memory.
+    // Arena::first/next also covers the underlying pools for usage info.
+    Arena *arena(const char *name, size_t size, int placement=LOOKY_SDRAM);
+
+    // Per-frame scratch arena, reset at the top of every frame, so only
+    // use this from the rendering thread (look/touch)
+    Arena &scratch();
+
+    // The LCD's palette, edits show up on the next frame, see Palette.h.
+    // Only use from the rendering thread (look/touch).
+    Palette &palette();
+
+    // Frame-time profile of the rendering loop, thingy i is section
+    // PROFILE_THINGS + i, see Profile.h. Only use from the rendering
+    // thread (look/touch).
+    const Profile &profile() const;
 
     void add(int x, int y, int w, int h, Thingy *thingy);
     void add(const Frame &f, int x, int y, int w, int h, Thingy *thingy);
 
+    // Mark part of the screen as needing a redraw, for changes that
+    // aren't owned by any one thingy (mode switches, etc). Only call
+    // from the rendering thread (look/touch).
+    void invalidate();
+    void invalidate(int x, int y, int w, int h);
+
 private:
     void loop();
+    void dispatch(const TouchEvent &e);
     std::vector<Frame>   _frames;
     std::vector<Thingy*> _things;
+    std::vector<uint16_t> _touching;
+    Damage _damage;
+    Touch _touch;
+    Arena *_scratch;
+    Profile _profile;
 };
 
 #endif
@@ -0,0 +1,148 @@
+#include "Palette.h"
+#include <assert.h>
+#include <string.h>
+
+Palette::Palette() {
+    reset(0, SIZE);
+    memset(_cycles, 0, sizeof(_cycles));
+    _pending = false;
+    commit();
+}
+
+uint16_t Palette::rgb(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3);
+}
+
+// maps 8-bit pixels (3:3:2) RGB onto the panel's 16-bit colors
+uint16_t Palette::rgb332(uint8_t p) {
+    return (
+            (((((p & 0xe0) >> 5)* 9)/2) << 10) |
+            (((((p & 0x1c) >> 2)* 9)/2) <<  5) |
+            (((((p & 0x03) >> 0)*21)/2) <<  0));
+}
+
+uint16_t Palette::lerp(uint16_t a, uint16_t b, int alpha) {
+    uint16_t c = 0;
+    for (int s = 0; s <= 10; s += 5) {
+        int x = (a >> s) & 0x1f;
+        int y = (b >> s) & 0x1f;
+        c |= (x + (((y - x)*alpha) >> 8)) << s;
+    }
+    return c;
+}
+
+void Palette::set(int i, uint16_t c) {
+    assert(i >= 0 && i < SIZE);
+    _colors[i] = c;
+    _changed = true;
+}
+
+void Palette::set(int first, int count, const uint16_t *colors) {
+    assert(first >= 0 && count >= 0 && first+count <= SIZE);
+    memcpy(&_colors[first], colors, count*sizeof(uint16_t));
+    _changed = true;
+}
+
+void Palette::reset(int first, int count) {
+    assert(first >= 0 && count >= 0 && first+count <= SIZE);
+    for (int i = first; i < first+count; i++) {
+        _colors[i] = rgb332(i);
+    }
+    _changed = true;
+}
+
+void Palette::rotate(int first, int count, int n) {
+    assert(first >= 0 && count >= 0 && first+count <= SIZE);
+    if (count == 0) {
+        return;
+    }
+
+    n = ((n % count) + count) % count;
+    uint16_t tmp[SIZE];
+    memcpy(tmp, &_colors[first], count*sizeof(uint16_t));
+    memcpy(&_colors[first+n], &tmp[0], (count-n)*sizeof(uint16_t));
+    memcpy(&_colors[first], &tmp[count-n], n*sizeof(uint16_t));
+    _changed = true;
+}
+
+void Palette::blend(int first, int count,
+        const uint16_t *a, const uint16_t *b, int alpha) {
+    assert(first >= 0 && count >= 0 && first+count <= SIZE);
+    for (int i = 0; i < count; i++) {
+        _colors[first+i] = lerp(a[i], b[i], alpha);
+    }
+    _changed = true;
+}
+
+int Palette::cycle(int first, int count, const uint16_t *colors, int speed) {
+    assert(first >= 0 && count > 0 && first+count <= SIZE);
+    for (int i = 0; i < MAX_CYCLES; i++) {
+        if (!_cycles[i].colors) {
+            Cycle c = {colors, first, count, speed, 0};
+            _cycles[i] = c;
+            draw(_cycles[i]);
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void Palette::stop(int cycle) {
+    if (cycle >= 0 && cycle < MAX_CYCLES) {
+        _cycles[cycle].colors = 0;
+    }
+}
+
+void Palette::draw(const Cycle &c) {
+    int phase = c.phase / 1000;
+    int k = phase >> 8;
+    int alpha = phase & 0xff;
+
+    // entry i shows colors[i-k], part way to colors[i-k-1]
+    for (int i = 0; i < c.count; i++) {
+        int j = i - k;
+        j = (j < 0) ? j + c.count : j;
+        int l = (j == 0) ? c.count-1 : j-1;
+        _colors[c.first+i] = lerp(c.colors[j], c.colors[l], alpha);
+    }
+    _changed = true;
+}
+
+void Palette::animate(int dt) {
+    for (int i = 0; i < MAX_CYCLES; i++) {
+        Cycle &c = _cycles[i];
+        if (!c.colors || !c.speed) {
+            continue;
+        }
+
+        int64_t period = (int64_t)c.count*256*1000;
+        c.phase = (c.phase + (int64_t)c.speed*dt) % period;
+        c.phase = (c.phase < 0) ? c.phase + period : c.phase;
+        draw(c);
+    }
+}
+
+void Palette::commit() {
+    if (!_changed) {
+        return;
+    }
+
+    // the IRQ can't preempt us halfway through an update, it just
+    // skips this vsync if it sees us copying
+    _pending = false;
+    __sync_synchronize();
+    memcpy(_shadow, _colors, sizeof(_shadow));
+    __sync_synchronize();
+    _pending = true;
+    _changed = false;
+}
+
+const uint16_t *Palette::vsync() {
+    if (!_pending) {
+        return 0;
+    }
+
+    _pending = false;
+    return _shadow;
+}
@@ -0,0 +1,89 @@
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Owner of the LCD's 256-entry palette
+ *
+ * Pixels are 8-bit indices, by default into a 3:3:2 RGB palette, but
+ * entries can be set, rotated and blended on the fly. Edits go to a
+ * working copy, commit publishes them, and the LCD IRQ loads them into
+ * the palette registers on the next vsync. Recoloring the screen costs
+ * a 512-byte register write instead of a redraw.
+ *
+ * Cycles are ranges that rotate on their own, LookyTouchy advances them
+ * every frame, so color-cycling effects only need to be drawn once.
+ *
+ * Colors are in the panel's 16-bit format, see rgb/rgb332. Everything
+ * but vsync belongs to the rendering thread.
+ */
+class Palette {
+public:
+    static const int SIZE = 256;
+    static const int MAX_CYCLES = 4;
+
+    // starts out as the default 3:3:2 palette
+    Palette();
+
+    // convert to the panel's format
+    static uint16_t rgb(uint8_t r, uint8_t g, uint8_t b);
+    static uint16_t rgb332(uint8_t p);
+
+    // blend two colors, alpha out of 256
+    static uint16_t lerp(uint16_t a, uint16_t b, int alpha);
+
+    uint16_t get(int i) const { return _colors[i]; }
+    void set(int i, uint16_t c);
+    void set(int first, int count, const uint16_t *colors);
+
+    // back to the default 3:3:2 colors
+    void reset(int first, int count);
+
+    // shift entries n places towards higher indices, wrapping around
+    void rotate(int first, int count, int n);
+
+    // set entries to a blend of a and b, alpha out of 256
+    void blend(int first, int count,
+            const uint16_t *a, const uint16_t *b, int alpha);
+
+    // Rotate colors through a range continuously, speed is in 256ths of
+    // an entry per second and in-between positions blend neighbors.
+    // colors must stick around until the cycle is stopped. Returns a
+    // handle for stop, or -1 if we're out of cycles.
+    int cycle(int first, int count, const uint16_t *colors, int speed);
+
+    // stop a cycle, its entries are left as they are
+    void stop(int cycle);
+
+    // advance cycles by dt milliseconds
+    void animate(int dt);
+
+    // publish edits, these show up on the next vsync
+    void commit();
+
+    // Called from the vsync IRQ, returns the palette to load if anything
+    // was committed since last time, NULL otherwise
+    const uint16_t *vsync();
+
+private:
+    struct Cycle {
+        const uint16_t *colors;
+        int first;
+        int count;
+        int speed;
+        int64_t phase;      // in 256000ths of an entry
+    };
+
+    void draw(const Cycle &c);
+
+    // the LCDC wants these as words
+    uint16_t _colors[SIZE] __attribute__((aligned(4)));
+    uint16_t _shadow[SIZE] __attribute__((aligned(4)));
+    Cycle _cycles[MAX_CYCLES];
+    bool _changed;
+    volatile bool _pending;
+};
+
+#endif
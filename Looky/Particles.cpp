@@ -0,0 +1,166 @@
+#include "Particles.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline int gridw(int w) {
+    return (w >> Particles::CELL_SHIFT) + 1;
+}
+
+static inline int gridh(int h) {
+    return (h >> Particles::CELL_SHIFT) + 1;
+}
+
+size_t Particles::footprint(int capacity, int w, int h) {
+    // x, y, vx, vy, sorted, and the grid
+    return 5*capacity*sizeof(int32_t)
+        + (gridw(w)*gridh(h) + 1)*sizeof(int32_t);
+}
+
+Particles::Particles()
+        : gravity(0)
+        , damping(1 << 16)
+        , floor(0)
+        , x(NULL), y(NULL), vx(NULL), vy(NULL)
+        , _capacity(0)
+        , _count(0)
+        , _dropped(0)
+        , _indexed(false)
+        , _gw(0)
+        , _gh(0)
+        , _cells(NULL)
+        , _sorted(NULL) {}
+
+void Particles::init(void *buffer, int capacity, int w, int h) {
+    int32_t *b = (int32_t*)buffer;
+    x  = b; b += capacity;
+    y  = b; b += capacity;
+    vx = b; b += capacity;
+    vy = b; b += capacity;
+    _sorted = b; b += capacity;
+    _cells = b;
+
+    _capacity = capacity;
+    _count = 0;
+    _dropped = 0;
+    _indexed = false;
+    _gw = gridw(w);
+    _gh = gridh(h);
+    memset(_cells, 0, (_gw*_gh + 1)*sizeof(int32_t));
+
+    floor = h << SHIFT;
+}
+
+int Particles::emit(int px, int py, int pvx, int pvy) {
+    if (_count >= _capacity) {
+        _dropped += 1;
+        return -1;
+    }
+
+    int i = _count++;
+    _indexed = false;
+    x[i] = px;
+    y[i] = py;
+    vx[i] = pvx;
+    vy[i] = pvy;
+    return i;
+}
+
+// random number in [-n, n]
+static inline int jitter(int n) {
+    return n ? (rand() % (2*n + 1)) - n : 0;
+}
+
+int Particles::emit(const Emitter &e) {
+    int n = 0;
+    for (int i = 0; i < e.rate; i++) {
+        int px = (e.x + (e.w ? rand() % e.w : 0)) << SHIFT;
+        int py = (e.y + (e.h ? rand() % e.h : 0)) << SHIFT;
+        if (emit(px, py, e.vx + jitter(e.spread),
+                e.vy + jitter(e.spread)) < 0) {
+            break;
+        }
+        n += 1;
+    }
+
+    return n;
+}
+
+void Particles::kill(int i) {
+    // swap in the last particle
+    _count -= 1;
+    _indexed = false;
+    x[i]  = x[_count];
+    y[i]  = y[_count];
+    vx[i] = vx[_count];
+    vy[i] = vy[_count];
+}
+
+int Particles::cell(int i) const {
+    int cx = x[i] >> (SHIFT + CELL_SHIFT);
+    int cy = y[i] >> (SHIFT + CELL_SHIFT);
+    cx = (cx < 0) ? 0 : (cx >= _gw) ? _gw-1 : cx;
+    cy = (cy < 0) ? 0 : (cy >= _gh) ? _gh-1 : cy;
+    return cy*_gw + cx;
+}
+
+void Particles::update() {
+    // integrate, one pass per axis so each loop only streams through
+    // two arrays
+    int n = _count;
+    if (damping != (1 << 16)) {
+        for (int i = 0; i < n; i++) {
+            x[i] += vx[i];
+            vx[i] = (int32_t)(((int64_t)vx[i] * damping) >> 16);
+        }
+
+        for (int i = 0; i < n; i++) {
+            y[i] += vy[i];
+            vy[i] = (int32_t)(((int64_t)(vy[i] + gravity) * damping) >> 16);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            x[i] += vx[i];
+        }
+
+        for (int i = 0; i < n; i++) {
+            y[i] += vy[i];
+            vy[i] += gravity;
+        }
+    }
+
+    // drop anything past the floor, backwards so swaps don't skip
+    for (int i = _count-1; i >= 0; i--) {
+        if (y[i] >= floor) {
+            kill(i);
+        }
+    }
+
+    _indexed = false;
+}
+
+void Particles::index() {
+    if (_indexed) {
+        return;
+    }
+
+    // rebuild the grid, count, prefix sum, then scatter backwards so
+    // each cell's offset ends up at its start
+    int cells = _gw*_gh;
+    memset(_cells, 0, (cells + 1)*sizeof(int32_t));
+    for (int i = 0; i < _count; i++) {
+        _cells[cell(i)] += 1;
+    }
+
+    int sum = 0;
+    for (int c = 0; c < cells; c++) {
+        sum += _cells[c];
+        _cells[c] = sum;
+    }
+    _cells[cells] = sum;
+
+    for (int i = _count-1; i >= 0; i--) {
+        _sorted[--_cells[cell(i)]] = i;
+    }
+
+    _indexed = true;
+}
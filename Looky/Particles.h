@@ -0,0 +1,121 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Struct-of-arrays particle engine
+ *
+ * Positions/velocities are fixed-point with SHIFT fractional bits, in
+ * screen space (y goes down). update() integrates, applies gravity and
+ * drag, and drops particles that fall past the floor. index() rebuilds
+ * a uniform grid for radius queries, only if anything changed. Dead
+ * particles are swapped out, so indices are only stable between updates.
+ *
+ * Memory comes from the caller, see footprint().
+ */
+class Particles {
+public:
+    // 1 pixel = 1 << SHIFT
+    static const int SHIFT = 10;
+    // grid cells are (1 << CELL_SHIFT) pixels on a side
+    static const int CELL_SHIFT = 4;
+
+    // spawns particles somewhere in a rect, velocities get a random
+    // +-spread added, all in fixed-point except the rect
+    struct Emitter {
+        int x, y, w, h;
+        int vx, vy;
+        int spread;
+        int rate;
+    };
+
+    // bytes needed for capacity particles over a w x h pixel area
+    static size_t footprint(int capacity, int w, int h);
+
+    Particles();
+    void init(void *buffer, int capacity, int w, int h);
+
+    // returns index of new particle, or -1 if we're full
+    int emit(int x, int y, int vx, int vy);
+    // returns number of particles actually emitted
+    int emit(const Emitter &e);
+
+    // integrate everything
+    void update();
+
+    // rebuild the grid for queries, cheap if nothing's changed
+    void index();
+
+    // calls f(i) for each particle within r pixels of x, y, call
+    // index() first
+    template <typename F>
+    void query(int x, int y, int r, F &f) const;
+
+    int count() const { return _count; }
+    int capacity() const { return _capacity; }
+    int dropped() const { return _dropped; }
+
+    // physics, per update and in fixed-point, damping is a 16-bit
+    // fraction velocities get multiplied by
+    int32_t gravity;
+    int32_t damping;
+    // particles past this are dead, in fixed-point
+    int32_t floor;
+
+    // the particles themselves
+    int32_t *x;
+    int32_t *y;
+    int32_t *vx;
+    int32_t *vy;
+
+private:
+    void kill(int i);
+    int cell(int i) const;
+
+    int _capacity;
+    int _count;
+    int _dropped;
+    bool _indexed;
+
+    // grid is a counting sort of particle indices by cell
+    int _gw;
+    int _gh;
+    int32_t *_cells;    // _gw*_gh + 1 offsets into _sorted
+    int32_t *_sorted;
+};
+
+template <typename F>
+void Particles::query(int qx, int qy, int r, F &f) const {
+    int cx1 = (qx - r) >> CELL_SHIFT;
+    int cy1 = (qy - r) >> CELL_SHIFT;
+    int cx2 = (qx + r) >> CELL_SHIFT;
+    int cy2 = (qy + r) >> CELL_SHIFT;
+    // particles off the grid live in its edge cells, so clamp onto the
+    // grid rather than skipping queries that are off it
+    cx1 = (cx1 < 0) ? 0 : (cx1 >= _gw) ? _gw-1 : cx1;
+    cy1 = (cy1 < 0) ? 0 : (cy1 >= _gh) ? _gh-1 : cy1;
+    cx2 = (cx2 < 0) ? 0 : (cx2 >= _gw) ? _gw-1 : cx2;
+    cy2 = (cy2 < 0) ? 0 : (cy2 >= _gh) ? _gh-1 : cy2;
+    if (cx1 > cx2 || cy1 > cy2) {
+        return;
+    }
+
+    int rr = r*r;
+    for (int cy = cy1; cy <= cy2; cy++) {
+        // cells in a row are contiguous in the sorted list
+        int start = _cells[cy*_gw + cx1];
+        int end = _cells[cy*_gw + cx2 + 1];
+        for (int k = start; k < end; k++) {
+            int i = _sorted[k];
+            int dx = (x[i] >> SHIFT) - qx;
+            int dy = (y[i] >> SHIFT) - qy;
+            if (dx*dx + dy*dy <= rr) {
+                f(i);
+            }
+        }
+    }
+}
+
+#endif
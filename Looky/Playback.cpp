@@ -0,0 +1,295 @@
+#include "Playback.h"
+#include "Profile.h"
+#include "rle.h"
+#include <math.h>
+
+// what we render when the device is empty, rings drifting outwards,
+// every other band lit in one of 4 colors, so a loop has to move the
+// rings a multiple of 8 bands to wrap cleanly
+#define RENDER_FRAMES 32
+#define RENDER_FPS 25
+#define RENDER_BAND 16
+#define RENDER_STEP 4
+
+// frames are decoded straight into the frame buffer as 3:3:2 bytes
+MBED_STATIC_ASSERT(sizeof(Frame::pixel_t) == 1 &&
+        (FormatSame<Frame::format_t, Format332>::value),
+        "Playback only plays into 3:3:2 frames");
+
+static uint32_t align_down(uint32_t x, uint32_t a) {
+    return x - x % a;
+}
+
+static uint32_t align_up(uint32_t x, uint32_t a) {
+    return align_down(x + a-1, a);
+}
+
+uint32_t Playback::Stats::kibps() const {
+    return ticks ? (uint32_t)(bytes*1000000*Profile::mhz()
+            / 1024 / ticks) : 0;
+}
+
+Playback::Playback(LookyTouchy *lt, BlockDevice *bd)
+    : _lt(lt), _bd(bd), _w(0), _h(0)
+    , _offsets(NULL), _canvas(NULL), _encoded(NULL)
+    , _playing(false), _next(0), _due(0), _free(2) {
+    memset(&_header, 0, sizeof(_header));
+    memset(_buffers, 0, sizeof(_buffers));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+int Playback::init(const Frame &f) {
+    // we render to fit whatever frame we were given
+    _w = f.w();
+    _h = f.h();
+    return 0;
+}
+
+int Playback::start() {
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    // nothing there? we'll render something on the reader thread, but
+    // allocations have to happen here
+    uint32_t r = _bd->get_read_size();
+    uint32_t max_size;
+    err = load();
+    if (err == BD_ERROR_DEVICE_ERROR) {
+        uint32_t p = _bd->get_program_size();
+        p = (r > p) ? r : p;
+        max_size = align_up(rle_bound(_w*_h), p);
+        _canvas = (uint8_t*)_lt->alloc(_w*_h);
+        _encoded = (uint8_t*)_lt->alloc(max_size);
+        _offsets = (uint32_t*)_lt->alloc(4*(RENDER_FRAMES+1));
+        if (!_canvas || !_encoded || !_offsets) {
+            return -ENOMEM;
+        }
+    } else if (err) {
+        return err;
+    } else {
+        max_size = _header.max_size;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        _buffers[i].data = (uint8_t*)_lt->alloc(align_up(max_size, r) + r);
+        if (!_buffers[i].data) {
+            return -ENOMEM;
+        }
+    }
+
+    return _thread.start(callback(this, &Playback::work));
+}
+
+// read the header and index, the index is small so it stays in memory
+int Playback::load() {
+    uint32_t r = _bd->get_read_size();
+    uint32_t size = align_up(sizeof(PlaybackHeader), r);
+    uint8_t *buffer = (uint8_t*)_lt->alloc(size);
+    if (!buffer) {
+        return -ENOMEM;
+    }
+
+    int err = _bd->read(buffer, 0, size);
+    if (err) {
+        return err;
+    }
+
+    PlaybackHeader h;
+    memcpy(&h, buffer, sizeof(h));
+    if (h.magic != PLAYBACK_MAGIC || h.frames == 0 || h.fps == 0 ||
+            h.w > _w || h.h > _h) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    size = align_up(sizeof(PlaybackHeader) + 4*(h.frames+1), r);
+    buffer = (uint8_t*)_lt->alloc(size);
+    if (!buffer) {
+        return -ENOMEM;
+    }
+
+    err = _bd->read(buffer, 0, size);
+    if (err) {
+        return err;
+    }
+
+    _header = h;
+    _offsets = (uint32_t*)&buffer[sizeof(PlaybackHeader)];
+    return 0;
+}
+
+// render our own animation into the device, the header goes in last so
+// a half-written animation never looks valid
+int Playback::render() {
+    printf("playback rendering %d frames\n", RENDER_FRAMES);
+    uint32_t p = _bd->get_program_size();
+    p = (_bd->get_read_size() > p) ? _bd->get_read_size() : p;
+    uint32_t e = _bd->get_erase_size();
+    uint32_t size = align_up(sizeof(PlaybackHeader) + 4*(RENDER_FRAMES+1), p);
+
+    // the header block first, so the old header's gone
+    int err = _bd->erase(0, align_up(size, e));
+    if (err) {
+        return err;
+    }
+
+    static const uint8_t colors[] = {0xe0, 0xfc, 0x1c, 0x1f};
+    uint32_t erased = align_up(size, e);
+    uint32_t off = size;
+    uint32_t max_size = 0;
+    for (int i = 0; i < RENDER_FRAMES; i++) {
+        for (int y = 0; y < _h; y++) {
+            for (int x = 0; x < _w; x++) {
+                int dx = x - _w/2;
+                int dy = y - _h/2;
+                int r = (int)sqrtf((float)(dx*dx + dy*dy));
+                int band = (r + RENDER_BAND*RENDER_FRAMES
+                        - RENDER_STEP*i) / RENDER_BAND;
+                _canvas[y*_w + x] = (band & 1)
+                        ? colors[(band/2) % sizeof(colors)] : 0x00;
+            }
+        }
+
+        uint32_t n = rle_encode(_encoded, _canvas, _w*_h);
+        max_size = (n > max_size) ? n : max_size;
+        uint32_t padded = align_up(n, p);
+        memset(&_encoded[n], 0xff, padded - n);
+
+        if (off + padded > _bd->size()) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+
+        // erase just ahead of where we're programming
+        if (off + padded > erased) {
+            uint32_t end = align_up(off + padded, e);
+            err = _bd->erase(erased, end - erased);
+            if (err) {
+                return err;
+            }
+            erased = end;
+        }
+
+        err = _bd->program(_encoded, off, padded);
+        if (err) {
+            return err;
+        }
+
+        _offsets[i] = off;
+        off += padded;
+    }
+    _offsets[RENDER_FRAMES] = off;
+
+    _header.magic = PLAYBACK_MAGIC;
+    _header.w = _w;
+    _header.h = _h;
+    _header.frames = RENDER_FRAMES;
+    _header.fps = RENDER_FPS;
+    _header.flags = PLAYBACK_RLE;
+    _header.max_size = max_size;
+
+    // the encode buffer's free now, and plenty big for the header
+    memset(_encoded, 0xff, size);
+    memcpy(_encoded, &_header, sizeof(_header));
+    memcpy(&_encoded[sizeof(_header)], _offsets, 4*(RENDER_FRAMES+1));
+    err = _bd->program(_encoded, 0, size);
+    if (err) {
+        return err;
+    }
+
+    printf("playback rendered %lu KiB\n", (unsigned long)off/1024);
+    return _bd->sync();
+}
+
+int Playback::read(Buffer &b, uint32_t frame) {
+    uint32_t r = _bd->get_read_size();
+    uint32_t start = align_down(_offsets[frame], r);
+    uint32_t end = align_up(_offsets[frame+1], r);
+
+    uint32_t t = Profile::now();
+    int err = _bd->read(b.data, start, end - start);
+    if (err) {
+        return err;
+    }
+    _stats.ticks += Profile::now() - t;
+    _stats.bytes += end - start;
+
+    b.off = _offsets[frame] - start;
+    b.size = _offsets[frame+1] - _offsets[frame];
+    return 0;
+}
+
+void Playback::work() {
+    if (_canvas) {
+        int err = render();
+        if (err) {
+            printf("playback render failed %d\n", err);
+            return;
+        }
+    }
+
+    printf("playback %dx%d, %d frames at %d fps\n",
+            _header.w, _header.h, _header.frames, _header.fps);
+
+    _playing = true;
+    int fill = 0;
+    while (true) {
+        for (uint32_t i = 0; i < _header.frames; i++) {
+            _free.wait();
+            int err = read(_buffers[fill], i);
+            if (err) {
+                printf("playback read failed %d\n", err);
+                return;
+            }
+
+            _buffers[fill].ready = true;
+            fill = 1 - fill;
+        }
+
+        // sustained read rate against what the animation needs
+        _stats.loops += 1;
+        uint32_t need = (uint32_t)(_stats.bytes / _stats.loops
+                * _header.fps / _header.frames / 1024);
+        printf("playback loop %lu, %lu KiB/s read, %lu KiB/s needed, "
+                "%lu late\n",
+                (unsigned long)_stats.loops, (unsigned long)_stats.kibps(),
+                (unsigned long)need, (unsigned long)_stats.late);
+    }
+}
+
+void Playback::look(const Frame &f, int dt) {
+    if (!_playing) {
+        return;
+    }
+
+    int period = 1000 / _header.fps;
+    _due += dt;
+    if (_due < period) {
+        return;
+    }
+
+    Buffer &b = _buffers[_next];
+    if (!b.ready) {
+        _stats.late += 1;
+        return;
+    }
+
+    // centered if we're bigger than the animation
+    uint8_t *dst = f.buffer((f.w() - _header.w)/2, (f.h() - _header.h)/2);
+    const uint8_t *src = &b.data[b.off];
+    if (_header.flags & PLAYBACK_RLE) {
+        rle_decoderect(dst, f.stride(), _header.w, _header.h, src, b.size);
+    } else if (b.size >= (uint32_t)_header.w*_header.h) {
+        for (int y = 0; y < _header.h; y++) {
+            memcpy(&dst[y*f.stride()], &src[y*_header.w], _header.w);
+        }
+    }
+
+    // don't try to catch up on frames we were late for, just carry on
+    _due = (_due - period < period) ? _due - period : 0;
+    _stats.frames += 1;
+
+    b.ready = false;
+    _next = 1 - _next;
+    _free.release();
+}
@@ -0,0 +1,104 @@
+#ifndef PLAYBACK_H
+#define PLAYBACK_H
+
+#include "mbed.h"
+#include "BlockDevice.h"
+#include "LookyTouchy.h"
+#include "Thingy.h"
+
+// animations live at the start of a block device, little-endian
+#define PLAYBACK_MAGIC 0x41594b4c   // "LKYA"
+
+enum {
+    PLAYBACK_RLE = 0x1,     // frames are rle_encoderect streams, else raw
+};
+
+struct PlaybackHeader {
+    uint32_t magic;
+    uint16_t w;
+    uint16_t h;
+    uint16_t frames;
+    uint16_t fps;
+    uint32_t flags;
+    uint32_t max_size;      // biggest frame, in bytes
+    // followed by frames+1 offsets, frame i is offset[i] to offset[i+1]
+};
+
+/**
+ * Streams 3:3:2 animation frames off a block device
+ *
+ * A reader thread keeps two frame buffers full, reading ahead while the
+ * rendering thread decodes the other one, so flash latency stays off the
+ * frame time. Frames are only decoded when they're due at the
+ * animation's fps, in between we're persistent and the last one stays
+ * up. If a frame isn't in yet when it's due we count it as late and try
+ * again next frame.
+ *
+ * With nothing on the device we render our own animation into it on
+ * first start, in the background. This erases whatever was there.
+ */
+class Playback : public Thingy {
+public:
+    struct Stats {
+        uint32_t loops;
+        uint32_t frames;
+        uint32_t late;      // frames that weren't read in time
+        uint64_t bytes;
+        uint64_t ticks;     // time spent reading, in Profile ticks
+
+        uint32_t kibps() const;
+    };
+
+    Playback(LookyTouchy *lt, BlockDevice *bd);
+
+    virtual int init(const Frame &f);
+    virtual void look(const Frame &f, int dt);
+
+    virtual bool persistent() const {
+        return true;
+    }
+
+    virtual const char *name() const {
+        return "playback";
+    }
+
+    // open the animation and start reading, after LookyTouchy::start
+    int start();
+
+    const PlaybackHeader &header() const { return _header; }
+    const Stats &stats() const { return _stats; }
+
+private:
+    struct Buffer {
+        uint8_t *data;
+        uint32_t off;       // reads are aligned, so frames start here
+        uint32_t size;
+        volatile bool ready;
+    };
+
+    int load();
+    int render();
+    int read(Buffer &b, uint32_t frame);
+    void work();
+
+    LookyTouchy *_lt;
+    BlockDevice *_bd;
+    int _w;
+    int _h;
+
+    PlaybackHeader _header;
+    uint32_t *_offsets;
+    uint8_t *_canvas;       // only if we have to render
+    uint8_t *_encoded;
+
+    volatile bool _playing;
+    Buffer _buffers[2];
+    int _next;
+    int _due;
+
+    Stats _stats;
+    Thread _thread;
+    Semaphore _free;
+};
+
+#endif
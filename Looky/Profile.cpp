@@ -0,0 +1,91 @@
+#include "Profile.h"
+#include "fsl_common.h"
+#include <string.h>
+#if !defined(DWT)
+#include <time.h>
+#endif
+
+Profile::Profile() : _frames(0), _windows(0) {
+#if defined(DWT)
+    // start the cycle counter, this is a debug feature so needs tracing
+    // turned on first
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t Profile::now() {
+#if defined(DWT)
+    return DWT->CYCCNT;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec);
+#endif
+}
+
+uint32_t Profile::us(uint32_t ticks) {
+    return ticks / mhz();
+}
+
+uint32_t Profile::mhz() {
+#if defined(DWT)
+    return SystemCoreClock / 1000000;
+#else
+    return 1000;
+#endif
+}
+
+void Profile::resize(int sections) {
+    Section s;
+    memset(&s, 0, sizeof(s));
+    s.min = (uint32_t)-1;
+    _sections.resize(sections, s);
+}
+
+void Profile::name(int section, const char *name) {
+    _sections[section].name = name;
+}
+
+const char *Profile::name(int section) const {
+    return _sections[section].name;
+}
+
+uint32_t Profile::lap(int section, uint32_t then) {
+    uint32_t t = now();
+    _sections[section].ticks += t - then;
+    return t;
+}
+
+void Profile::frame() {
+    for (unsigned i = 0; i < _sections.size(); i++) {
+        Section &s = _sections[i];
+        s.min = (s.ticks < s.min) ? s.ticks : s.min;
+        s.max = (s.ticks > s.max) ? s.ticks : s.max;
+        s.sum += s.ticks;
+        s.ticks = 0;
+    }
+
+    _frames += 1;
+    if (_frames < WINDOW) {
+        return;
+    }
+
+    for (unsigned i = 0; i < _sections.size(); i++) {
+        Section &s = _sections[i];
+        s.stats.min = us(s.min);
+        s.stats.avg = us(s.sum / WINDOW);
+        s.stats.max = us(s.max);
+        s.min = (uint32_t)-1;
+        s.max = 0;
+        s.sum = 0;
+    }
+
+    _frames = 0;
+    _windows += 1;
+}
+
+const Profile::Stats &Profile::stats(int section) const {
+    return _sections[section].stats;
+}
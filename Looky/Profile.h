@@ -0,0 +1,78 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <vector>
+
+// fixed profile sections, thingy i is PROFILE_THINGS + i
+enum {
+    PROFILE_FRAME,      // the whole frame, including the vsync wait
+    PROFILE_COPY,       // copying last frame's damage forward
+    PROFILE_CLEAR,      // collecting and clearing damage
+    PROFILE_PALETTE,    // palette cycles and commit
+    PROFILE_TOUCH,      // touch snapshot and dispatch
+    PROFILE_VSYNC,      // waiting for vsync
+
+    PROFILE_THINGS,
+};
+
+/**
+ * Frame-time profiler for the rendering loop
+ *
+ * Sections are timed in ticks, the DWT cycle counter on target and a
+ * steady clock on the host, and summed over each frame. Every WINDOW
+ * frames the per-frame min/avg/max of each section is published in
+ * microseconds. Sections that don't run in a frame count as 0 for it.
+ *
+ * Only the rendering thread should touch this.
+ */
+class Profile {
+public:
+    static const int WINDOW = 32;
+
+    struct Stats {
+        uint32_t min;
+        uint32_t avg;
+        uint32_t max;
+    };
+
+    Profile();
+
+    // current ticks, ticks to microseconds, and ticks per microsecond
+    static uint32_t now();
+    static uint32_t us(uint32_t ticks);
+    static uint32_t mhz();
+
+    void resize(int sections);
+    int count() const { return _sections.size(); }
+
+    // names are only for display, NULL if we don't have one
+    void name(int section, const char *name);
+    const char *name(int section) const;
+
+    // add the time since then to a section, returns now for chaining
+    uint32_t lap(int section, uint32_t then);
+
+    // end a frame, publishes stats every WINDOW frames
+    void frame();
+
+    // stats from the last full window, and how many windows we've had
+    const Stats &stats(int section) const;
+    uint32_t windows() const { return _windows; }
+
+private:
+    struct Section {
+        const char *name;
+        uint32_t ticks;
+        uint32_t min;
+        uint32_t max;
+        uint64_t sum;
+        Stats stats;
+    };
+
+    std::vector<Section> _sections;
+    int _frames;
+    uint32_t _windows;
+};
+
+#endif
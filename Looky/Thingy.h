@@ -1,15 +1,93 @@
 #ifndef THINGY_H
 #define THINGY_H
 
+#include "mbed.h"
 #include "Frame.h"
+#include "Damage.h"
+#include "Touch.h"
 #include "fsl_ft5406.h"
 
 // Abstract class for renderable elements
 class Thingy {
 public:
+    Thingy() : _invalid(1), _dx1(0), _dy1(0), _dx2(0), _dy2(0) {}
+
     virtual int init(const Frame &f) { return 0; }
     virtual void look(const Frame &f, int dt) {}
     virtual void touch(const Frame &f, int x, int y) {}
+
+    // Multi-touch events, only sent when a contact goes down in, moves
+    // in, or leaves our frame. By default this maps onto touch, with
+    // -1, -1 when a contact leaves.
+    virtual void touchevent(const Frame &f, const TouchEvent &e) {
+        if (e.type == TOUCH_UP) {
+            touch(f, -1, -1);
+        } else {
+            touch(f, e.x, e.y);
+        }
+    }
+
+    // Damage tracking, animated thingies are redrawn every frame.
+    // Thingies that only change sometimes should return false here and
+    // call invalidate whenever they need to be redrawn.
+    virtual bool animated() const { return true; }
+
+    // Persistent thingies draw on top of their last frame, so their
+    // damage is redrawn but not cleared. Since they may be redrawn when
+    // something under them changes, keep them animated or idempotent.
+    virtual bool persistent() const { return false; }
+
+    // shows up in the profiler, NULL if we don't care
+    virtual const char *name() const { return 0; }
+
+    // mark whole thingy for redrawing, safe from other threads
+    void invalidate() {
+        _invalid = 1;
+    }
+
+    // mark part of thingy for redrawing, in thingy's coordinates,
+    // only call this from look/touch
+    void invalidate(int x, int y, int w, int h) {
+        if (w <= 0 || h <= 0) {
+            return;
+        }
+
+        if (_dx1 == _dx2) {
+            _dx1 = x; _dy1 = y; _dx2 = x+w; _dy2 = y+h;
+        } else {
+            _dx1 = (x   < _dx1) ? x   : _dx1;
+            _dy1 = (y   < _dy1) ? y   : _dy1;
+            _dx2 = (x+w > _dx2) ? x+w : _dx2;
+            _dy2 = (y+h > _dy2) ? y+h : _dy2;
+        }
+    }
+
+    // called by LookyTouchy to collect pending damage in screen
+    // coordinates, clears it afterwards
+    void takedamage(const Frame &f, Damage &d) {
+        // read and clear in one go, or an invalidate from another thread
+        // between the two would be lost
+        uint8_t invalid = 1;
+        core_util_atomic_cas_u8(&_invalid, &invalid, 0);
+
+        if (animated() || invalid) {
+            d.add(f.x(), f.y(), f.w(), f.h());
+        } else if (_dx1 != _dx2) {
+            // clip to our frame
+            int x1 = (_dx1 > 0)     ? _dx1 : 0;
+            int y1 = (_dy1 > 0)     ? _dy1 : 0;
+            int x2 = (_dx2 < f.w()) ? _dx2 : f.w();
+            int y2 = (_dy2 < f.h()) ? _dy2 : f.h();
+            d.add(f.x() + x1, f.y() + y1, x2-x1, y2-y1);
+        }
+
+        _dx1 = _dx2 = 0;
+    }
+
+private:
+    volatile uint8_t _invalid;
+    int _dx1, _dy1;
+    int _dx2, _dy2;
 };
 
 #endif
@@ -0,0 +1,85 @@
+#include "Touch.h"
+
+Touch::Touch()
+        : _head(0)
+        , _tail(0)
+        , _dropped(0) {
+    for (int i = 0; i < MAX_CONTACTS; i++) {
+        _contacts[i].active = false;
+    }
+}
+
+void Touch::update(int count, const touch_point_t *points) {
+    for (int i = 0; i < MAX_CONTACTS; i++) {
+        _contacts[i].seen = false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const touch_point_t &p = points[i];
+        if (p.TOUCH_EVENT != kTouch_Down && p.TOUCH_EVENT != kTouch_Contact) {
+            // lifted contacts just stop showing up, handled below
+            continue;
+        }
+
+        // find our contact, or a free slot for a new one
+        contact *c = 0;
+        contact *free = 0;
+        for (int j = 0; j < MAX_CONTACTS; j++) {
+            if (_contacts[j].active && _contacts[j].id == p.TOUCH_ID) {
+                c = &_contacts[j];
+                break;
+            } else if (!_contacts[j].active && !free) {
+                free = &_contacts[j];
+            }
+        }
+
+        if (c) {
+            // held contacts report a move every snapshot, even if they
+            // haven't moved, so thingies can keep reacting to them
+            c->x = p.TOUCH_X;
+            c->y = p.TOUCH_Y;
+            c->seen = true;
+            push(TOUCH_MOVE, c->id, c->x, c->y);
+        } else if (free) {
+            free->active = true;
+            free->id = p.TOUCH_ID;
+            free->x = p.TOUCH_X;
+            free->y = p.TOUCH_Y;
+            free->seen = true;
+            push(TOUCH_DOWN, free->id, free->x, free->y);
+        }
+    }
+
+    // anything we didn't see was lifted
+    for (int i = 0; i < MAX_CONTACTS; i++) {
+        contact *c = &_contacts[i];
+        if (c->active && !c->seen) {
+            c->active = false;
+            push(TOUCH_UP, c->id, c->x, c->y);
+        }
+    }
+}
+
+void Touch::push(int type, int id, int x, int y) {
+    if (_tail - _head >= (unsigned)QUEUE_SIZE) {
+        _dropped += 1;
+        return;
+    }
+
+    TouchEvent &e = _queue[_tail % QUEUE_SIZE];
+    e.type = type;
+    e.id = id;
+    e.x = x;
+    e.y = y;
+    _tail += 1;
+}
+
+bool Touch::pop(TouchEvent *e) {
+    if (_head == _tail) {
+        return false;
+    }
+
+    *e = _queue[_head % QUEUE_SIZE];
+    _head += 1;
+    return true;
+}
@@ -0,0 +1,64 @@
+#ifndef TOUCH_H
+#define TOUCH_H
+
+#include "fsl_ft5406.h"
+
+// touch event types
+enum {
+    TOUCH_DOWN,
+    TOUCH_MOVE,
+    TOUCH_UP,
+};
+
+struct TouchEvent {
+    int type;
+    int id;     // constant from down to up
+    int x;
+    int y;
+};
+
+/**
+ * Tracks contacts across multi-touch snapshots by their TOUCH_ID
+ * and turns them into down/move/up events in a fixed-size queue
+ *
+ * The queue is sized so a drained-every-update queue can't overflow,
+ * if it does anyways the newest events are dropped and counted.
+ */
+class Touch {
+public:
+    static const int MAX_CONTACTS = FT5406_MAX_TOUCHES;
+    // worst case an update lifts every contact and adds as many new
+    // ones, must be a power of two
+    static const int QUEUE_SIZE = 16;
+
+    Touch();
+
+    // feed in a snapshot from FT5406_GetMultiTouch, coordinates
+    // should already be in screen space
+    void update(int count, const touch_point_t *points);
+
+    // pop the next event, returns false if there aren't any
+    bool pop(TouchEvent *e);
+
+    int dropped() const { return _dropped; }
+
+private:
+    void push(int type, int id, int x, int y);
+
+    struct contact {
+        bool active;
+        bool seen;
+        int id;
+        int x;
+        int y;
+    };
+
+    contact _contacts[MAX_CONTACTS];
+
+    TouchEvent _queue[QUEUE_SIZE];
+    unsigned _head;
+    unsigned _tail;
+    int _dropped;
+};
+
+#endif
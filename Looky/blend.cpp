@@ -0,0 +1,54 @@
+#include "blend.h"
+
+// the table Frame blends with, this is zero-initialized so it's safe to
+// check from anywhere, even during static init
+static const uint8_t *table;
+
+const uint8_t *blend_table() {
+    return table;
+}
+
+void blend_settable(const uint8_t *lut) {
+    table = lut;
+}
+
+// blend a channel at level l, rounding to nearest
+static inline int blend_channel(int s, int d, int l) {
+    return (s*l + d*(BLEND_LEVELS-l) + BLEND_LEVELS/2) / BLEND_LEVELS;
+}
+
+uint8_t blend332_slow(uint8_t src, uint8_t dst, int l) {
+    int r = blend_channel(src >> 5,       dst >> 5,       l);
+    int g = blend_channel((src >> 2) & 7, (dst >> 2) & 7, l);
+    int b = blend_channel(src & 3,        dst & 3,        l);
+    return (r << 5) | (g << 2) | b;
+}
+
+// channels blend independently, so we build each level out of small
+// per-channel tables, this keeps startup quick on the M4
+void blend_init(uint8_t *lut) {
+    for (int l = 1; l < BLEND_LEVELS; l++) {
+        uint8_t r[8][8];
+        uint8_t g[8][8];
+        uint8_t b[4][4];
+        for (int s = 0; s < 8; s++) {
+            for (int d = 0; d < 8; d++) {
+                r[s][d] = blend_channel(s, d, l) << 5;
+                g[s][d] = blend_channel(s, d, l) << 2;
+                if (s < 4 && d < 4) {
+                    b[s][d] = blend_channel(s, d, l);
+                }
+            }
+        }
+
+        for (int s = 0; s < 256; s++) {
+            const uint8_t *rs = r[s >> 5];
+            const uint8_t *gs = g[(s >> 2) & 7];
+            const uint8_t *bs = b[s & 3];
+            uint8_t *row = &lut[((l-1) << 16) | (s << 8)];
+            for (int d = 0; d < 256; d++) {
+                row[d] = rs[d >> 5] | gs[(d >> 2) & 7] | bs[d & 3];
+            }
+        }
+    }
+}
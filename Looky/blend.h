@@ -0,0 +1,62 @@
+#ifndef BLEND_H
+#define BLEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Lookup table blending for 3:3:2 frame buffers
+ *
+ * Blending 3:3:2 pixels means unpacking, multiplying and repacking
+ * three channels, so instead we precompute every src over dst for a
+ * handful of coverage levels and blending is one table lookup. Each
+ * level is a 256x256 table indexed by src and dst, 64KiB apiece, so
+ * the tables live in SDRAM. Levels 0 and BLEND_LEVELS are just dst
+ * and src, so they aren't stored.
+ *
+ * This assumes the default 3:3:2 palette, palette effects will blend
+ * in the wrong colors.
+ */
+#ifndef LOOKY_BLEND_BITS
+#define LOOKY_BLEND_BITS 3
+#endif
+
+#define BLEND_LEVELS (1 << LOOKY_BLEND_BITS)
+#define BLEND_SHIFT (8 - LOOKY_BLEND_BITS)
+
+// bytes of table needed for blend_init
+static inline size_t blend_size() {
+    return (BLEND_LEVELS-1)*256*256;
+}
+
+// build the tables, this takes a few ms
+void blend_init(uint8_t *lut);
+
+// the tables Frame blends with, these are NULL until someone sets them
+// up, in which case anti-aliased drawing just rounds coverage
+const uint8_t *blend_table();
+void blend_settable(const uint8_t *lut);
+
+// coverage a out of 255 to a blend level
+static inline int blend_level(int a) {
+    return (a + (1 << (BLEND_SHIFT-1))) >> BLEND_SHIFT;
+}
+
+// blend src over dst at level l out of BLEND_LEVELS, the slow way, this
+// is what the tables are built from
+uint8_t blend332_slow(uint8_t src, uint8_t dst, int l);
+
+// blend src over dst with coverage a out of 255
+static inline uint8_t blend332(const uint8_t *lut,
+        uint8_t src, uint8_t dst, int a) {
+    int l = blend_level(a);
+    if (l == 0) {
+        return dst;
+    } else if (l == BLEND_LEVELS) {
+        return src;
+    }
+
+    return lut[((l-1) << 16) | (src << 8) | dst];
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include "fade.h"
+#include <string.h>
+
+// fade n < 8 bytes through a word
+static inline uint64_t fadebytes(uint8_t *p, int n, uint64_t dec) {
+    uint64_t x64 = 0;
+    memcpy(&x64, p, n);
+    x64 = fade332x8(x64, dec);
+    memcpy(p, &x64, n);
+    return x64;
+}
+
+// fade a run of n bytes, returns nonzero if anything is still lit
+static uint64_t faderun(uint8_t *p, int n, uint64_t dec) {
+    uint64_t lit = 0;
+    for (; n >= 8; n -= 8) {
+        uint64_t x64;
+        memcpy(&x64, p, sizeof(x64));
+        if (x64) {
+            x64 = fade332x8(x64, dec);
+            memcpy(p, &x64, sizeof(x64));
+            lit |= x64;
+        }
+        p += 8;
+    }
+
+    if (n > 0) {
+        lit |= fadebytes(p, n, dec);
+    }
+
+    return lit;
+}
+
+void faderect332(uint8_t *dst, int stride, int w, int h, uint64_t dec,
+        uint32_t *occupancy) {
+    int spans = (w + FADE_SPAN-1) / FADE_SPAN;
+
+    for (int y = 0; y < h; y++) {
+        uint8_t *row = dst + y*stride;
+
+        if (!occupancy) {
+            faderun(row, w, dec);
+        } else {
+            for (int s = 0; s < spans; s++) {
+                int i = y*spans + s;
+                uint32_t bit = 1U << (i % 32);
+                if (!(occupancy[i / 32] & bit)) {
+                    // black, don't even look at it
+                    continue;
+                }
+
+                int n = (s == spans-1) ? w - s*FADE_SPAN : FADE_SPAN;
+                if (!faderun(row + s*FADE_SPAN, n, dec)) {
+                    occupancy[i / 32] &= ~bit;
+                }
+            }
+        }
+
+        dec = (dec << 8) | (dec >> 56);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef FADE_H
+#define FADE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * SWAR fade kernels for 3:3:2 frame buffers
+ *
+ * These subtract a per-pixel decrement from each of R, G and B with
+ * saturation, eight pixels to a 64-bit word. The decrement is in the
+ * same 3:3:2 format, so 0x25 takes one step off every channel.
+ *
+ * An optional occupancy bitmap, a bit per FADE_SPAN bytes of each row,
+ * lets us skip black spans without loading them. Anything drawing into
+ * a faded rect needs to fade_mark what it touches.
+ */
+#define FADE_SPAN 64
+
+// fade eight packed pixels
+static inline uint64_t fade332x8(uint64_t p, uint64_t dec) {
+    const uint64_t ones = 0x0101010101010101ULL;
+
+    // Each field gets a guard bit just above it, so a field that
+    // would go negative only clears its own guard and never borrows
+    // from its neighbour. Red sits at the top, so shift it down one.
+    uint64_t r = (((p >> 1) & (0x70*ones)) | (0x80*ones))
+            - ((dec >> 1) & (0x70*ones));
+    uint64_t g = ((p & (0x1c*ones)) | (0x20*ones)) - (dec & (0x1c*ones));
+    uint64_t b = ((p & (0x03*ones)) | (0x04*ones)) - (dec & (0x03*ones));
+
+    // guard bits tell us which fields survived, expand them to masks
+    r = (r & (0x70*ones)) & (((r >> 7) & ones) * 0x70);
+    g = (g & (0x1c*ones)) & (((g >> 5) & ones) * 0x1c);
+    b = (b & (0x03*ones)) & (((b >> 2) & ones) * 0x03);
+
+    return (r << 1) | g | b;
+}
+
+// words of occupancy bitmap needed for a w x h rect
+static inline size_t fade_occupancy_size(int w, int h) {
+    int spans = (w + FADE_SPAN-1) / FADE_SPAN;
+    return (spans*h + 31) / 32;
+}
+
+// mark a pixel as lit in an occupancy bitmap
+static inline void fade_mark(uint32_t *occupancy, int w, int x, int y) {
+    int spans = (w + FADE_SPAN-1) / FADE_SPAN;
+    int i = y*spans + x/FADE_SPAN;
+    occupancy[i / 32] |= 1U << (i % 32);
+}
+
+// Fade a w x h rect with rows stride bytes apart. dec is rotated a
+// pixel each row so sparse decrement patterns dither. occupancy may be
+// NULL, otherwise spans are skipped/cleared as they go black.
+void faderect332(uint8_t *dst, int stride, int w, int h, uint64_t dec,
+        uint32_t *occupancy);
+
+#endif
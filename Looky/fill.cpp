@@ -0,0 +1,227 @@
+#include "fill.h"
+#include <string.h>
+
+// replicate a byte across all lanes of a word
+static inline uint64_t splat8(uint8_t p) {
+    return 0x0101010101010101ULL * p;
+}
+
+// aligned burst, dst must be 64-bit aligned, n counts words
+static inline void fill64(uint64_t *dst, uint64_t p64, size_t n) {
+    // unrolled so the core can pipeline the stores back-to-back
+    for (; n >= 4; n -= 4) {
+        dst[0] = p64;
+        dst[1] = p64;
+        dst[2] = p64;
+        dst[3] = p64;
+        dst += 4;
+    }
+
+    for (; n > 0; n--) {
+        *dst++ = p64;
+    }
+}
+
+void fill8(uint8_t *dst, uint8_t p, size_t n) {
+    // bytewise until we're aligned
+    while (n > 0 && ((uintptr_t)dst & 7)) {
+        *dst++ = p;
+        n -= 1;
+    }
+
+    // words in the middle
+    fill64((uint64_t*)dst, splat8(p), n / 8);
+    dst += n & ~(size_t)7;
+    n &= 7;
+
+    // and whatever's left over
+    while (n > 0) {
+        *dst++ = p;
+        n -= 1;
+    }
+}
+
+void fillrect8(uint8_t *dst, int stride, int w, int h, uint8_t p) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    // contiguous rows? just one big span
+    if (w == stride) {
+        fill8(dst, p, (size_t)w*h);
+        return;
+    }
+
+    // if the stride is word aligned, every row has the same head/tail
+    // split, so work it out once and only loop over the words per row
+    if ((stride & 7) || w < 16) {
+        for (int i = 0; i < h; i++) {
+            fill8(dst + i*stride, p, w);
+        }
+        return;
+    }
+
+    int head = (int)(-(uintptr_t)dst & 7);
+    int words = (w - head) / 8;
+    int tail = (w - head) & 7;
+    uint64_t p64 = splat8(p);
+
+    for (int i = 0; i < h; i++) {
+        uint8_t *row = dst + i*stride;
+        for (int j = 0; j < head; j++) {
+            row[j] = p;
+        }
+
+        row += head;
+        fill64((uint64_t*)row, p64, words);
+        row += 8*words;
+
+        for (int j = 0; j < tail; j++) {
+            row[j] = p;
+        }
+    }
+}
+
+void copyrect8(uint8_t *dst, const uint8_t *src, int stride, int w, int h) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    // contiguous rows? just one big copy
+    if (w == stride) {
+        memcpy(dst, src, (size_t)w*h);
+        return;
+    }
+
+    // both buffers share a stride, so memcpy sees the same alignment
+    // for src and dst on every row and can stay word-wide
+    for (int i = 0; i < h; i++) {
+        memcpy(dst + i*stride, src + i*stride, w);
+    }
+}
+
+// the bits of a byte from bit a up to bit b, msb first
+static inline uint8_t bitmask(int a, int b) {
+    return (uint8_t)((0xff >> a) & (0xff << (8 - b)));
+}
+
+void fillbits(uint8_t *dst, int bit, int bits, uint8_t pattern) {
+    if (bits <= 0) {
+        return;
+    }
+
+    dst += bit / 8;
+    bit %= 8;
+
+    // all inside one byte?
+    if (bit + bits <= 8) {
+        uint8_t m = bitmask(bit, bit + bits);
+        *dst = (*dst & ~m) | (pattern & m);
+        return;
+    }
+
+    // masked head, whole bytes, masked tail
+    if (bit) {
+        uint8_t m = bitmask(bit, 8);
+        *dst = (*dst & ~m) | (pattern & m);
+        dst += 1;
+        bits -= 8 - bit;
+    }
+
+    fill8(dst, pattern, bits / 8);
+    dst += bits / 8;
+
+    if (bits % 8) {
+        uint8_t m = bitmask(0, bits % 8);
+        *dst = (*dst & ~m) | (pattern & m);
+    }
+}
+
+void fillrectbits(uint8_t *dst, int stride, int bit, int bits, int h,
+        uint8_t pattern) {
+    if (bits <= 0 || h <= 0) {
+        return;
+    }
+
+    // whole rows? just one big span
+    if (bit == 0 && bits == 8*stride) {
+        fill8(dst, pattern, (size_t)stride*h);
+        return;
+    }
+
+    for (int i = 0; i < h; i++) {
+        fillbits(dst + i*stride, bit, bits, pattern);
+    }
+}
+
+void copyrectbits(uint8_t *dst, const uint8_t *src, int stride,
+        int bit, int bits, int h) {
+    if (bits <= 0 || h <= 0) {
+        return;
+    }
+
+    dst += bit / 8;
+    src += bit / 8;
+    bit %= 8;
+
+    // split like fillbits, the same for every row
+    int end = bit + bits;
+    if (end <= 8) {
+        uint8_t m = bitmask(bit, end);
+        for (int i = 0; i < h; i++) {
+            dst[i*stride] = (dst[i*stride] & ~m) | (src[i*stride] & m);
+        }
+        return;
+    }
+
+    uint8_t hm = bit ? bitmask(bit, 8) : 0;
+    int head = bit ? 1 : 0;
+    int bytes = (end - 8*head) / 8;
+    uint8_t tm = (end % 8) ? bitmask(0, end % 8) : 0;
+    int tail = head + bytes;
+
+    for (int i = 0; i < h; i++) {
+        uint8_t *d = dst + i*stride;
+        const uint8_t *s = src + i*stride;
+        if (hm) {
+            d[0] = (d[0] & ~hm) | (s[0] & hm);
+        }
+        memcpy(&d[head], &s[head], bytes);
+        if (tm) {
+            d[tail] = (d[tail] & ~tm) | (s[tail] & tm);
+        }
+    }
+}
+
+void fill16(uint16_t *dst, uint16_t p, size_t n) {
+    // halfwords until we're aligned
+    while (n > 0 && ((uintptr_t)dst & 7)) {
+        *dst++ = p;
+        n -= 1;
+    }
+
+    fill64((uint64_t*)dst, 0x0001000100010001ULL * p, n / 4);
+    dst += n & ~(size_t)3;
+    n &= 3;
+
+    while (n > 0) {
+        *dst++ = p;
+        n -= 1;
+    }
+}
+
+void fillrect16(uint8_t *dst, int stride, int w, int h, uint16_t p) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    // contiguous rows? just one big span
+    if (2*w == stride) {
+        fill16((uint16_t*)dst, p, (size_t)w*h);
+        return;
+    }
+
+    for (int i = 0; i < h; i++) {
+        fill16((uint16_t*)(dst + i*stride), p, w);
+    }
+}
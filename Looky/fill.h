@@ -0,0 +1,40 @@
+#ifndef FILL_H
+#define FILL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Word-wide fill/copy kernels for frame buffers
+ *
+ * These handle unaligned heads/tails bytewise and write the middle of
+ * each span as aligned 64-bit bursts. No mbed dependencies here so the
+ * kernels can be benchmarked on the host.
+ *
+ * Sub-byte pixels are packed msb first, spans of them are measured in
+ * bits, and only the partial bytes at either end need masking.
+ */
+
+// fill n bytes starting at dst with p
+void fill8(uint8_t *dst, uint8_t p, size_t n);
+
+// fill a w x h rect in a frame buffer with a stride of stride bytes,
+// dst points at the rect's top-left pixel
+void fillrect8(uint8_t *dst, int stride, int w, int h, uint8_t p);
+
+// copy a w x h rect between two frame buffers with the same stride
+void copyrect8(uint8_t *dst, const uint8_t *src, int stride, int w, int h);
+
+// fill/copy a span of bits bits wide, starting bit bits into dst, for
+// 1/2/4-bit pixels, pattern is the pixel repeated across a byte
+void fillbits(uint8_t *dst, int bit, int bits, uint8_t pattern);
+void fillrectbits(uint8_t *dst, int stride, int bit, int bits, int h,
+        uint8_t pattern);
+void copyrectbits(uint8_t *dst, const uint8_t *src, int stride,
+        int bit, int bits, int h);
+
+// 16-bit pixels, dst must be 16-bit aligned
+void fill16(uint16_t *dst, uint16_t p, size_t n);
+void fillrect16(uint8_t *dst, int stride, int w, int h, uint16_t p);
+
+#endif
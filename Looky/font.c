@@ -1,107 +1,135 @@
 #include "font.h"
 
-const unsigned char font[] = {
-    0x00, 0x00, 0x00, 0x00,     // Space
-    0x5f, 0x00, 0x00, 0x00,     // !
-    0x03, 0x00, 0x03, 0x00,     // "
-    0x14, 0x3e, 0x14, 0x00,     // #
-    0x2e, 0x6b, 0x3a, 0x00,     // $
-    0x62, 0x18, 0x46, 0x00,     // %
-    0x14, 0x6b, 0x22, 0x00,     // &
-    0x00, 0x03, 0x00, 0x00,     // '
-
-    0x1c, 0x22, 0x41, 0x00,     // (
-    0x41, 0x22, 0x1c, 0x00,     // )
-    0x14, 0x08, 0x14, 0x00,     // *
-    0x08, 0x1c, 0x08, 0x00,     // +
-    0x60, 0x00, 0x00, 0x00,     // ,
-    0x08, 0x08, 0x08, 0x00,     // -
-    0x40, 0x00, 0x00, 0x00,     // .
-    0x60, 0x18, 0x06, 0x00,     // /
-
-    0x7f, 0x41, 0x7f, 0x00,     // 0
-    0x42, 0x7f, 0x40, 0x00,     // 1
-    0x7d, 0x45, 0x47, 0x00,     // 2
-    0x45, 0x45, 0x7f, 0x00,     // 3
-    0x1f, 0x10, 0x7f, 0x00,     // 4
-    0x47, 0x45, 0x7d, 0x00,     // 5
-    0x7f, 0x45, 0x7d, 0x00,     // 6
-    0x01, 0x01, 0x7f, 0x00,     // 7
+// Glyphs are FONT_WIDTH columns, bit j of each column is row j. Kept as
+// an x-macro so we can derive the row-major masks at compile time.
+#define FONT_GLYPHS(G) \
+    G(0x00, 0x00, 0x00, 0x00)     /* Space */ \
+    G(0x5f, 0x00, 0x00, 0x00)     /* ! */     \
+    G(0x03, 0x00, 0x03, 0x00)     /* " */     \
+    G(0x14, 0x3e, 0x14, 0x00)     /* # */     \
+    G(0x2e, 0x6b, 0x3a, 0x00)     /* $ */     \
+    G(0x62, 0x18, 0x46, 0x00)     /* % */     \
+    G(0x14, 0x6b, 0x22, 0x00)     /* & */     \
+    G(0x00, 0x03, 0x00, 0x00)     /* ' */     \
+                                              \
+    G(0x1c, 0x22, 0x41, 0x00)     /* ( */     \
+    G(0x41, 0x22, 0x1c, 0x00)     /* ) */     \
+    G(0x14, 0x08, 0x14, 0x00)     /* * */     \
+    G(0x08, 0x1c, 0x08, 0x00)     /* + */     \
+    G(0x60, 0x00, 0x00, 0x00)     /* , */     \
+    G(0x08, 0x08, 0x08, 0x00)     /* - */     \
+    G(0x40, 0x00, 0x00, 0x00)     /* . */     \
+    G(0x60, 0x18, 0x06, 0x00)     /* / */     \
+                                              \
+    G(0x7f, 0x41, 0x7f, 0x00)     /* 0 */     \
+    G(0x42, 0x7f, 0x40, 0x00)     /* 1 */     \
+    G(0x7d, 0x45, 0x47, 0x00)     /* 2 */     \
+    G(0x45, 0x45, 0x7f, 0x00)     /* 3 */     \
+    G(0x1f, 0x10, 0x7f, 0x00)     /* 4 */     \
+    G(0x47, 0x45, 0x7d, 0x00)     /* 5 */     \
+    G(0x7f, 0x45, 0x7d, 0x00)     /* 6 */     \
+    G(0x01, 0x01, 0x7f, 0x00)     /* 7 */     \
+                                              \
+    G(0x7f, 0x45, 0x7f, 0x00)     /* 8 */     \
+    G(0x5f, 0x51, 0x7f, 0x00)     /* 9 */     \
+    G(0x00, 0x14, 0x00, 0x00)     /* : */     \
+    G(0x40, 0x34, 0x00, 0x00)     /* ; */     \
+    G(0x08, 0x14, 0x22, 0x00)     /* < */     \
+    G(0x14, 0x14, 0x14, 0x00)     /* = */     \
+    G(0x22, 0x14, 0x08, 0x00)     /* > */     \
+    G(0x59, 0x0f, 0x00, 0x00)     /* ? */     \
+                                              \
+    G(0x3a, 0x22, 0x3e, 0x00)     /* @ */     \
+    G(0x7f, 0x11, 0x7f, 0x00)     /* A */     \
+    G(0x7f, 0x45, 0x3a, 0x00)     /* B */     \
+    G(0x7f, 0x41, 0x63, 0x00)     /* C */     \
+    G(0x7f, 0x41, 0x3e, 0x00)     /* D */     \
+    G(0x7f, 0x45, 0x45, 0x00)     /* E */     \
+    G(0x7f, 0x05, 0x05, 0x00)     /* F */     \
+    G(0x7f, 0x41, 0x7d, 0x00)     /* G */     \
+    G(0x7f, 0x04, 0x7f, 0x00)     /* H */     \
+    G(0x41, 0x7f, 0x41, 0x00)     /* I */     \
+    G(0x40, 0x41, 0x7f, 0x00)     /* J */     \
+    G(0x7f, 0x04, 0x7b, 0x00)     /* K */     \
+    G(0x7f, 0x40, 0x40, 0x00)     /* L */     \
+    G(0x7f, 0x06, 0x7f, 0x00)     /* M */     \
+    G(0x7f, 0x01, 0x7f, 0x00)     /* N */     \
+    G(0x7f, 0x41, 0x7f, 0x00)     /* O */     \
+                                              \
+    G(0x7f, 0x11, 0x1f, 0x00)     /* P */     \
+    G(0x3f, 0x61, 0x5f, 0x00)     /* Q */     \
+    G(0x7f, 0x05, 0x7b, 0x00)     /* R */     \
+    G(0x47, 0x45, 0x7d, 0x00)     /* S */     \
+    G(0x01, 0x7f, 0x01, 0x00)     /* T */     \
+    G(0x7F, 0x40, 0x7f, 0x00)     /* U */     \
+    G(0x7f, 0x20, 0x1f, 0x00)     /* V */     \
+    G(0x7f, 0x30, 0x7f, 0x00)     /* W */     \
+    G(0x7b, 0x04, 0x7b, 0x00)     /* X */     \
+    G(0x07, 0x7c, 0x07, 0x00)     /* Y */     \
+    G(0x79, 0x45, 0x43, 0x00)     /* Z */     \
+    G(0x00, 0x7f, 0x41, 0x00)     /* [ */     \
+    G(0x06, 0x18, 0x60, 0x00)     /* "\" */   \
+    G(0x41, 0x7f, 0x00, 0x00)     /* ] */     \
+    G(0x02, 0x01, 0x02, 0x00)     /* ^ */     \
+    G(0x40, 0x40, 0x40, 0x00)     /* _ */     \
+                                              \
+    G(0x01, 0x02, 0x00, 0x00)     /* ` */     \
+    G(0x74, 0x54, 0x7c, 0x00)     /* a */     \
+    G(0x7f, 0x44, 0x7c, 0x00)     /* b */     \
+    G(0x7c, 0x44, 0x44, 0x00)     /* c */     \
+    G(0x7c, 0x44, 0x7f, 0x00)     /* d */     \
+    G(0x7c, 0x54, 0x5c, 0x00)     /* e */     \
+    G(0x04, 0x7f, 0x05, 0x00)     /* f */     \
+    G(0x5c, 0x54, 0x7c, 0x00)     /* g */     \
+    G(0x7f, 0x04, 0x7c, 0x00)     /* h */     \
+    G(0x04, 0x7d, 0x00, 0x00)     /* i */     \
+    G(0x40, 0x7d, 0x00, 0x00)     /* j */     \
+    G(0x7f, 0x10, 0x6c, 0x00)     /* k */     \
+    G(0x00, 0x7f, 0x40, 0x00)     /* l */     \
+                                              \
+    G(0x7c, 0x18, 0x7c, 0x00)     /* m */     \
+    G(0x7c, 0x04, 0x7c, 0x00)     /* n */     \
+    G(0x7c, 0x44, 0x7c, 0x00)     /* o */     \
+    G(0x7c, 0x24, 0x3c, 0x00)     /* p */     \
+    G(0x3c, 0x24, 0x7c, 0x00)     /* q */     \
+    G(0x7c, 0x04, 0x04, 0x00)     /* r */     \
+    G(0x5c, 0x54, 0x74, 0x00)     /* s */     \
+    G(0x04, 0x7e, 0x44, 0x00)     /* t */     \
+    G(0x7c, 0x40, 0x7c, 0x00)     /* u */     \
+    G(0x7c, 0x20, 0x1c, 0x00)     /* v */     \
+    G(0x7c, 0x30, 0x7c, 0x00)     /* w */     \
+    G(0x6c, 0x10, 0x6c, 0x00)     /* x */     \
+    G(0x5c, 0x50, 0x7c, 0x00)     /* y */     \
+    G(0x64, 0x54, 0x4c, 0x00)     /* z */     \
+                                              \
+    G(0x08, 0x7f, 0x41, 0x00)     /* { */     \
+    G(0x00, 0x7f, 0x00, 0x00)     /* | */     \
+    G(0x41, 0x7f, 0x08, 0x00)     /* } */     \
+    G(0x04, 0x0c, 0x08, 0x00)     /* ~ */
 
-    0x7f, 0x45, 0x7f, 0x00,     // 8
-    0x5f, 0x51, 0x7f, 0x00,     // 9
-    0x00, 0x14, 0x00, 0x00,     // :
-    0x40, 0x34, 0x00, 0x00,     // ;
-    0x08, 0x14, 0x22, 0x00,     // <
-    0x14, 0x14, 0x14, 0x00,     // =
-    0x22, 0x14, 0x08, 0x00,     // >
-    0x59, 0x0f, 0x00, 0x00,     // ?
+// column-major, bit-per-pixel
+#define FONT_COLUMNS(a, b, c, d) a, b, c, d,
 
-    0x3a, 0x22, 0x3e, 0x00,     // @
-    0x7f, 0x11, 0x7f, 0x00,     // A
-    0x7f, 0x45, 0x3a, 0x00,     // B
-    0x7f, 0x41, 0x63, 0x00,     // C
-    0x7f, 0x41, 0x3e, 0x00,     // D
-    0x7f, 0x45, 0x45, 0x00,     // E
-    0x7f, 0x05, 0x05, 0x00,     // F
-    0x7f, 0x41, 0x7d, 0x00,     // G
-    0x7f, 0x04, 0x7f, 0x00,     // H
-    0x41, 0x7f, 0x41, 0x00,     // I
-    0x40, 0x41, 0x7f, 0x00,     // J
-    0x7f, 0x04, 0x7b, 0x00,     // K
-    0x7f, 0x40, 0x40, 0x00,     // L
-    0x7f, 0x06, 0x7f, 0x00,     // M
-    0x7f, 0x01, 0x7f, 0x00,     // N
-    0x7f, 0x41, 0x7f, 0x00,     // O
-
-    0x7f, 0x11, 0x1f, 0x00,     // P
-    0x3f, 0x61, 0x5f, 0x00,     // Q
-    0x7f, 0x05, 0x7b, 0x00,     // R
-    0x47, 0x45, 0x7d, 0x00,     // S
-    0x01, 0x7f, 0x01, 0x00,     // T
-    0x7F, 0x40, 0x7f, 0x00,     // U
-    0x7f, 0x20, 0x1f, 0x00,     // V
-    0x7f, 0x30, 0x7f, 0x00,     // W
-    0x7b, 0x04, 0x7b, 0x00,     // X
-    0x07, 0x7c, 0x07, 0x00,     // Y
-    0x79, 0x45, 0x43, 0x00,     // Z
-    0x00, 0x7f, 0x41, 0x00,     // [
-    0x06, 0x18, 0x60, 0x00,     // "\"
-    0x41, 0x7f, 0x00, 0x00,     // ]
-    0x02, 0x01, 0x02, 0x00,     // ^
-    0x40, 0x40, 0x40, 0x00,     // _
+const unsigned char font[] = {
+    FONT_GLYPHS(FONT_COLUMNS)
+};
 
-    0x01, 0x02, 0x00, 0x00,     // `
-    0x74, 0x54, 0x7c, 0x00,     // a
-    0x7f, 0x44, 0x7c, 0x00,     // b
-    0x7c, 0x44, 0x44, 0x00,     // c
-    0x7c, 0x44, 0x7f, 0x00,     // d
-    0x7c, 0x54, 0x5c, 0x00,     // e
-    0x04, 0x7f, 0x05, 0x00,     // f
-    0x5c, 0x54, 0x7c, 0x00,     // g
-    0x7f, 0x04, 0x7c, 0x00,     // h
-    0x04, 0x7d, 0x00, 0x00,     // i
-    0x40, 0x7d, 0x00, 0x00,     // j
-    0x7f, 0x10, 0x6c, 0x00,     // k
-    0x00, 0x7f, 0x40, 0x00,     // l
+// row-major, a nibble per row with bit i being column i
+#define FONT_ROW(a, b, c, d, j) (                    \
+        ((((a) >> (j)) & 1) << 0) |                 \
+        ((((b) >> (j)) & 1) << 1) |                 \
+        ((((c) >> (j)) & 1) << 2) |                 \
+        ((((d) >> (j)) & 1) << 3))
 
-    0x7c, 0x18, 0x7c, 0x00,     // m
-    0x7c, 0x04, 0x7c, 0x00,     // n
-    0x7c, 0x44, 0x7c, 0x00,     // o
-    0x7c, 0x24, 0x3c, 0x00,     // p
-    0x3c, 0x24, 0x7c, 0x00,     // q
-    0x7c, 0x04, 0x04, 0x00,     // r
-    0x5c, 0x54, 0x74, 0x00,     // s
-    0x04, 0x7e, 0x44, 0x00,     // t
-    0x7c, 0x40, 0x7c, 0x00,     // u
-    0x7c, 0x20, 0x1c, 0x00,     // v
-    0x7c, 0x30, 0x7c, 0x00,     // w
-    0x6c, 0x10, 0x6c, 0x00,     // x
-    0x5c, 0x50, 0x7c, 0x00,     // y
-    0x64, 0x54, 0x4c, 0x00,     // z
+#define FONT_ROWS(a, b, c, d) (                     \
+        ((uint32_t)FONT_ROW(a, b, c, d, 0) <<  0) | \
+        ((uint32_t)FONT_ROW(a, b, c, d, 1) <<  4) | \
+        ((uint32_t)FONT_ROW(a, b, c, d, 2) <<  8) | \
+        ((uint32_t)FONT_ROW(a, b, c, d, 3) << 12) | \
+        ((uint32_t)FONT_ROW(a, b, c, d, 4) << 16) | \
+        ((uint32_t)FONT_ROW(a, b, c, d, 5) << 20) | \
+        ((uint32_t)FONT_ROW(a, b, c, d, 6) << 24)),
 
-    0x08, 0x7f, 0x41, 0x00,     // {
-    0x00, 0x7f, 0x00, 0x00,     // |
-    0x41, 0x7f, 0x08, 0x00,     // }
-    0x04, 0x0c, 0x08, 0x00,     // ~
+const uint32_t font_rows[] = {
+    FONT_GLYPHS(FONT_ROWS)
 };
@@ -1,10 +1,15 @@
-
 #ifndef FONT_H
 #define FONT_H
 
+#include <stdint.h>
+
 #define FONT_WIDTH 4
 #define FONT_HEIGHT 7
 
+// column-major, a byte per column
 extern const unsigned char font[];
 
+// row-major, a nibble per row packed into a word per glyph
+extern const uint32_t font_rows[];
+
 #endif
@@ -0,0 +1,198 @@
+#include "image.h"
+#include "rle.h"
+#include <string.h>
+
+// packed bytes are decoded this many at a time, XORed rows always fit
+#define IMAGE_CHUNK IMAGE_MAX_ROW
+
+int image_info(ImageHeader *h, const uint8_t *img, size_t size) {
+    if (size < sizeof(ImageHeader)) {
+        return -1;
+    }
+
+    memcpy(h, img, sizeof(ImageHeader));
+    if (h->magic != IMAGE_MAGIC ||
+            !(h->bpp == 1 || h->bpp == 2 || h->bpp == 4 || h->bpp == 8) ||
+            (h->colors == 0 && h->bpp != 8) ||
+            h->colors > (1 << h->bpp) ||
+            ((h->flags & IMAGE_XOR) && (!(h->flags & IMAGE_RLE) ||
+                (h->w*h->bpp + 7)/8 > IMAGE_MAX_ROW)) ||
+            size < sizeof(ImageHeader) + h->colors) {
+        return -1;
+    }
+
+    return 0;
+}
+
+// expands packed pixels into 3:3:2, a nibble at a time
+struct Expander {
+    int bpp;
+    int ppn;                // pixels per nibble, 0 for 8-bit
+    const uint8_t *palette; // NULL for raw 3:3:2
+    uint32_t lut[16];
+
+    Expander(const ImageHeader &h, const uint8_t *pal) {
+        bpp = h.bpp;
+        ppn = 4 / bpp;
+        palette = h.colors ? pal : NULL;
+        if (bpp == 8) {
+            return;
+        }
+
+        // each nibble's pixels packed little-endian, first pixel first
+        int mask = (1 << bpp) - 1;
+        for (int n = 0; n < 16; n++) {
+            uint32_t x = 0;
+            for (int i = 0; i < ppn; i++) {
+                int p = (n >> (4 - bpp*(i+1))) & mask;
+                uint8_t c = (p < h.colors) ? pal[p] : 0;
+                x |= (uint32_t)c << 8*i;
+            }
+            lut[n] = x;
+        }
+    }
+
+    // expand n packed bytes covering pixels [px, ...) into the window
+    // [sx, sx+w) of a row
+    void expand(uint8_t *row, int sx, int w,
+            const uint8_t *src, int n, int px) const {
+        int ppb = 8 / bpp;
+        int i = 0;
+
+        // whole bytes inside the window go through the lut
+        for (; i < n; i++, px += ppb) {
+            int x = px - sx;
+            if (x + ppb <= 0) {
+                continue;
+            } else if (x >= w) {
+                return;
+            } else if (x < 0 || x + ppb > w) {
+                // straddles an edge, a pixel at a time
+                for (int j = 0; j < ppb; j++) {
+                    if (x+j >= 0 && x+j < w) {
+                        row[x+j] = bytepixel(src[i], j);
+                    }
+                }
+                continue;
+            }
+
+            uint8_t b = src[i];
+            switch (bpp) {
+                case 8:
+                    row[x] = palette ? palette[b] : b;
+                    break;
+                case 4:
+                    row[x+0] = lut[b >> 4];
+                    row[x+1] = lut[b & 0xf];
+                    break;
+                case 2: {
+                    uint16_t hi = lut[b >> 4];
+                    uint16_t lo = lut[b & 0xf];
+                    memcpy(&row[x+0], &hi, 2);
+                    memcpy(&row[x+2], &lo, 2);
+                    break;
+                }
+                case 1:
+                    memcpy(&row[x+0], &lut[b >> 4], 4);
+                    memcpy(&row[x+4], &lut[b & 0xf], 4);
+                    break;
+            }
+        }
+    }
+
+    // pixel j of a packed byte
+    uint8_t bytepixel(uint8_t b, int j) const {
+        if (bpp == 8) {
+            return palette ? palette[b] : b;
+        }
+
+        int nibble = (j < ppn) ? b >> 4 : b & 0xf;
+        return lut[nibble] >> 8*(j % ppn);
+    }
+};
+
+int image_decoderect(uint8_t *dst, int stride, int sx, int sy, int w, int h,
+        const uint8_t *img, size_t size) {
+    ImageHeader hdr;
+    if (image_info(&hdr, img, size)) {
+        return -1;
+    }
+
+    // clip the window to the image
+    if (sx < 0) { dst -= sx; w += sx; sx = 0; }
+    if (sy < 0) { dst -= sy*stride; h += sy; sy = 0; }
+    w = (sx + w < hdr.w) ? w : hdr.w - sx;
+    h = (sy + h < hdr.h) ? h : hdr.h - sy;
+    if (w <= 0 || h <= 0) {
+        return 0;
+    }
+
+    const uint8_t *palette = &img[sizeof(ImageHeader)];
+    const uint8_t *pixels = palette + hdr.colors;
+    size_t left = size - (pixels - img);
+    Expander e(hdr, palette);
+
+    int ppb = 8 / hdr.bpp;
+    int rowbytes = (hdr.w + ppb-1) / ppb;
+
+    // raw rows can be skipped, RLE has to be decoded up to our window
+    RLEStream s;
+    int y = 0;
+    if (hdr.flags & IMAGE_RLE) {
+        rle_stream(s, pixels, left);
+    } else {
+        if (left < (size_t)(sy + h)*rowbytes) {
+            return -1;
+        }
+        pixels += sy*rowbytes;
+        y = sy;
+    }
+
+    // bytes past the window's right edge are decoded but not expanded
+    bool xor_ = hdr.flags & IMAGE_XOR;
+    int last = (sx + w + ppb-1) / ppb;
+    uint8_t buffer[IMAGE_CHUNK];
+    uint8_t prev[IMAGE_MAX_ROW];
+    if (xor_) {
+        memset(prev, 0, rowbytes);
+    }
+
+    for (; y < sy + h; y++) {
+        uint8_t *row = (y >= sy) ? &dst[(y-sy)*stride] : NULL;
+        for (int i = 0; i < rowbytes; i += IMAGE_CHUNK) {
+            int n = (rowbytes - i < IMAGE_CHUNK) ? rowbytes - i : IMAGE_CHUNK;
+            const uint8_t *chunk;
+            if (hdr.flags & IMAGE_RLE) {
+                if (rle_read(s, buffer, n) != (size_t)n) {
+                    return -1;
+                }
+                chunk = buffer;
+            } else {
+                chunk = &pixels[i];
+            }
+
+            if (xor_) {
+                // nothing changed since the row above? just copy it
+                uint8_t changed = 0;
+                for (int j = 0; j < n; j++) {
+                    prev[i+j] ^= buffer[j];
+                    changed |= buffer[j];
+                }
+                chunk = &prev[i];
+
+                if (!changed && row && y > sy) {
+                    memcpy(row, row - stride, w);
+                    continue;
+                }
+            }
+
+            if (row && i < last) {
+                e.expand(row, sx, w, chunk, n, i*ppb);
+            }
+        }
+
+        pixels += rowbytes;
+    }
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Compact images for flash, decoded straight into 8-bit frame buffers
+ *
+ * Pixels are palette indices of 1, 2, 4 or 8 bits, packed msb first with
+ * each row padded to a byte, optionally RLE-coded as one stream. Rows can
+ * also be XORed with the row above first, which turns anything that
+ * repeats vertically into runs of zeros. The palette maps indices to
+ * 3:3:2 colors, 8-bit images can skip it and store 3:3:2 directly.
+ * Decoding streams a row at a time through small stack buffers, there's
+ * never a whole image in RAM.
+ *
+ * tools/bmp2image converts BMPs to this at build time.
+ */
+#define IMAGE_MAGIC 0x494b594c  // "LKYI"
+
+// longest packed row IMAGE_XOR works with, we keep the last one around
+#define IMAGE_MAX_ROW 128
+
+enum {
+    IMAGE_RLE = 0x1,        // pixel rows are an rle_encode stream
+    IMAGE_XOR = 0x2,        // rows are XORed with the row above, needs RLE
+};
+
+struct ImageHeader {
+    uint32_t magic;
+    uint16_t w;
+    uint16_t h;
+    uint8_t bpp;
+    uint8_t flags;
+    uint16_t colors;        // palette entries, 3:3:2 bytes after this
+};
+
+// check an image and read its header, returns -1 if it's bad
+int image_info(ImageHeader *h, const uint8_t *img, size_t size);
+
+// Decode the w x h window at sx, sy of an image into a rect with
+// stride, dst points at the rect's top-left pixel. The window is
+// clipped to the image. Returns -1 if the image is bad or truncated.
+int image_decoderect(uint8_t *dst, int stride, int sx, int sy, int w, int h,
+        const uint8_t *img, size_t size);
+
+#endif
@@ -0,0 +1,182 @@
+#include "rle.h"
+#include <string.h>
+
+// feeds bytes of a rect in order, as if rows were contiguous
+struct RectReader {
+    const uint8_t *row;
+    int stride;
+    int w;
+    int x;
+    size_t left;
+
+    uint8_t peek(size_t i) const {
+        int x2 = x + (int)i;
+        return row[(x2 / w)*stride + x2 % w];
+    }
+
+    void skip(size_t n) {
+        int x2 = x + (int)n;
+        row += (x2 / w)*stride;
+        x = x2 % w;
+        left -= n;
+    }
+};
+
+static size_t encode(uint8_t *dst, RectReader &r) {
+    uint8_t *start = dst;
+    uint8_t *literal = 0;
+
+    while (r.left > 0) {
+        // how long is the run here
+        uint8_t p = r.peek(0);
+        size_t run = 1;
+        while (run < r.left && run < RLE_MAX_RUN && r.peek(run) == p) {
+            run += 1;
+        }
+
+        if (run >= 3) {
+            *dst++ = 0x80 + (run - 3);
+            *dst++ = p;
+            literal = 0;
+            r.skip(run);
+            continue;
+        }
+
+        // extend the current literal, or start a new one
+        if (!literal || *literal == RLE_MAX_LITERAL-1) {
+            literal = dst++;
+            *literal = (uint8_t)-1;
+        }
+
+        for (size_t i = 0; i < run; i++) {
+            if (*literal == RLE_MAX_LITERAL-1) {
+                literal = dst++;
+                *literal = (uint8_t)-1;
+            }
+            *literal += 1;
+            *dst++ = p;
+        }
+        r.skip(run);
+    }
+
+    return dst - start;
+}
+
+size_t rle_encode(uint8_t *dst, const uint8_t *src, size_t n) {
+    if (n == 0) {
+        return 0;
+    }
+
+    RectReader r = {src, 0, (int)n, 0, n};
+    return encode(dst, r);
+}
+
+size_t rle_encoderect(uint8_t *dst, const uint8_t *src, int stride,
+        int w, int h) {
+    if (w <= 0 || h <= 0) {
+        return 0;
+    }
+
+    RectReader r = {src, stride, w, 0, (size_t)w*h};
+    return encode(dst, r);
+}
+
+void rle_stream(RLEStream &s, const uint8_t *src, size_t size) {
+    s.p = src;
+    s.end = src + size;
+    s.left = 0;
+    s.run = false;
+}
+
+size_t rle_read(RLEStream &s, uint8_t *dst, size_t n) {
+    size_t done = 0;
+    while (done < n) {
+        if (s.left == 0) {
+            if (s.p >= s.end) {
+                break;
+            }
+
+            uint8_t ctl = *s.p++;
+            s.run = (ctl >= 0x80);
+            s.left = s.run ? ctl - 0x80 + 3 : ctl + 1;
+            if (s.end - s.p < (s.run ? 1 : s.left)) {
+                s.p = s.end;
+                s.left = 0;
+                break;
+            }
+        }
+
+        size_t chunk = (n - done < (size_t)s.left) ? n - done : s.left;
+        if (s.run) {
+            memset(&dst[done], *s.p, chunk);
+        } else {
+            memcpy(&dst[done], s.p, chunk);
+            s.p += chunk;
+        }
+
+        done += chunk;
+        s.left -= chunk;
+        if (s.run && s.left == 0) {
+            s.p += 1;
+        }
+    }
+
+    return done;
+}
+
+int rle_decoderect(uint8_t *dst, int stride, int w, int h,
+        const uint8_t *src, size_t size) {
+    const uint8_t *p = src;
+    const uint8_t *end = src + size;
+    uint8_t *row = dst;
+    int x = 0;
+    int y = 0;
+
+    while (y < h) {
+        if (p >= end) {
+            return -1;
+        }
+
+        uint8_t ctl = *p++;
+        int n;
+        bool run = (ctl >= 0x80);
+        if (run) {
+            n = ctl - 0x80 + 3;
+            if (p >= end) {
+                return -1;
+            }
+        } else {
+            n = ctl + 1;
+            if (end - p < n) {
+                return -1;
+            }
+        }
+
+        // split the chunk across rows
+        while (n > 0 && y < h) {
+            int chunk = (n < w - x) ? n : w - x;
+            if (run) {
+                memset(&row[x], *p, chunk);
+            } else {
+                memcpy(&row[x], p, chunk);
+                p += chunk;
+            }
+
+            n -= chunk;
+            x += chunk;
+            if (x == w) {
+                x = 0;
+                y += 1;
+                row += stride;
+            }
+        }
+
+        if (run) {
+            p += 1;
+        } else {
+            p += n;
+        }
+    }
+
+    return p - src;
+}
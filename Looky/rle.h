@@ -0,0 +1,49 @@
+#ifndef RLE_H
+#define RLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Byte run-length coding for 8-bit frames
+ *
+ * PackBits-style, each chunk starts with a control byte. Below 0x80 it's
+ * followed by ctl+1 literal bytes, from 0x80 up it's followed by one
+ * byte repeated ctl-0x80+3 times. Runs under 3 aren't worth it, so they
+ * stay literal. Runs carry across rows, decoding into a rect wraps at
+ * its width, so frames encode as one stream.
+ */
+#define RLE_MAX_LITERAL 128
+#define RLE_MAX_RUN     130
+
+// worst case encoded size of n bytes
+static inline size_t rle_bound(size_t n) {
+    return n + (n + RLE_MAX_LITERAL-1) / RLE_MAX_LITERAL;
+}
+
+// encode n bytes, dst needs rle_bound(n), returns encoded size
+size_t rle_encode(uint8_t *dst, const uint8_t *src, size_t n);
+
+// encode a w x h rect with stride, as if its rows were contiguous
+size_t rle_encoderect(uint8_t *dst, const uint8_t *src, int stride,
+        int w, int h);
+
+// streaming decoder, for when the output isn't one rect
+struct RLEStream {
+    const uint8_t *p;
+    const uint8_t *end;
+    int left;           // bytes left in the current chunk
+    bool run;
+};
+
+void rle_stream(RLEStream &s, const uint8_t *src, size_t size);
+
+// decode the next n bytes, returns how many we got, short if src ran out
+size_t rle_read(RLEStream &s, uint8_t *dst, size_t n);
+
+// Decode into a w x h rect with stride. Returns bytes of src used, or
+// -1 if src ran out before the rect filled up.
+int rle_decoderect(uint8_t *dst, int stride, int w, int h,
+        const uint8_t *src, size_t size);
+
+#endif
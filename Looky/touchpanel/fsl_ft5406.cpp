@@ -78,6 +78,13 @@ status_t FT5406_Init(ft5406_handle_t *handle, I2C_Type *base)
     memset(xfer, 0, sizeof(*xfer));
     memset(handle->touch_buf, 0, FT5406_TOUCH_DATA_LEN);
 
+    /* no snapshot yet */
+    memset(&handle->i2c_handle, 0, sizeof(handle->i2c_handle));
+    handle->busy = false;
+    handle->seq = 0;
+    handle->touch_count = 0;
+    memset(handle->touch_array, 0, sizeof(handle->touch_array));
+
     /* set device mode to normal operation */
     mode = 0;
     xfer->slaveAddress = 0x38;
@@ -111,6 +118,12 @@ status_t FT5406_Denit(ft5406_handle_t *handle)
         return kStatus_InvalidArgument;
     }
 
+    if (handle->busy)
+    {
+        I2C_MasterTransferAbort(handle->base, &handle->i2c_handle);
+        handle->busy = false;
+    }
+
     handle->base = NULL;
     return kStatus_Success;
 }
@@ -161,6 +174,43 @@ status_t FT5406_GetSingleTouch(ft5406_handle_t *handle, touch_event_t *touch_eve
     return status;
 }
 
+static void FT5406_DecodeMultiTouch(const uint8_t *touch_buf, int *touch_count, touch_point_t touch_array[FT5406_MAX_TOUCHES])
+{
+    const ft5406_touch_data_t *touch_data = (const ft5406_touch_data_t *)(const void *)(touch_buf);
+    int count = touch_data->TD_STATUS;
+    int i;
+
+    /* Controller reports garbage counts when idle, clamp them */
+    if (count > (int)FT5406_MAX_TOUCHES)
+    {
+        count = FT5406_MAX_TOUCHES;
+    }
+
+    /* Decode number of touches */
+    if (touch_count)
+    {
+        *touch_count = count;
+    }
+
+    /* Decode valid touch points */
+    for (i = 0; i < count; i++)
+    {
+        touch_array[i].TOUCH_ID = TOUCH_POINT_GET_ID(touch_data->TOUCH[i]);
+        touch_array[i].TOUCH_EVENT = TOUCH_POINT_GET_EVENT(touch_data->TOUCH[i]);
+        touch_array[i].TOUCH_X = TOUCH_POINT_GET_X(touch_data->TOUCH[i]);
+        touch_array[i].TOUCH_Y = TOUCH_POINT_GET_Y(touch_data->TOUCH[i]);
+    }
+
+    /* Clear vacant elements of touch_array */
+    for (; i < (int)FT5406_MAX_TOUCHES; i++)
+    {
+        touch_array[i].TOUCH_ID = 0;
+        touch_array[i].TOUCH_EVENT = kTouch_Reserved;
+        touch_array[i].TOUCH_X = 0;
+        touch_array[i].TOUCH_Y = 0;
+    }
+}
+
 status_t FT5406_GetMultiTouch(ft5406_handle_t *handle, int *touch_count, touch_point_t touch_array[FT5406_MAX_TOUCHES])
 {
     status_t status;
@@ -169,31 +219,135 @@ status_t FT5406_GetMultiTouch(ft5406_handle_t *handle, int *touch_count, touch_p
 
     if (status == kStatus_Success)
     {
-        ft5406_touch_data_t *touch_data = (ft5406_touch_data_t *)(void *)(handle->touch_buf);
-        int i;
+        FT5406_DecodeMultiTouch(handle->touch_buf, touch_count, touch_array);
+    }
 
-        /* Decode number of touches */
-        if (touch_count)
-        {
-            *touch_count = touch_data->TD_STATUS;
-        }
+    return status;
+}
+
+/* Runs in I2C interrupt context, publishes a new snapshot */
+static void FT5406_TransferCallback(I2C_Type *base, i2c_master_handle_t *i2c_handle, status_t status, void *userData)
+{
+    ft5406_handle_t *handle = (ft5406_handle_t *)userData;
+
+    if (status == kStatus_Success)
+    {
+        handle->seq += 1;
+        __sync_synchronize();
+
+        FT5406_DecodeMultiTouch(handle->touch_buf, &handle->touch_count, handle->touch_array);
+
+        __sync_synchronize();
+        handle->seq += 1;
+    }
+
+    handle->busy = false;
+}
+
+status_t FT5406_ReadTouchDataAsync(ft5406_handle_t *handle)
+{
+    status_t status;
+
+    assert(handle);
+
+    if (!handle || !handle->base)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (handle->busy)
+    {
+        return kStatus_I2C_Busy;
+    }
+
+    /* handle is created lazily so blocking-only users don't pay for it */
+    if (handle->i2c_handle.completionCallback != FT5406_TransferCallback)
+    {
+        I2C_MasterTransferCreateHandle(handle->base, &handle->i2c_handle, FT5406_TransferCallback, handle);
+    }
+
+    handle->busy = true;
+    status = I2C_MasterTransferNonBlocking(handle->base, &handle->i2c_handle, &handle->xfer);
+    if (status != kStatus_Success)
+    {
+        handle->busy = false;
+    }
+
+    return status;
+}
 
-        /* Decode valid touch points */
-        for (i = 0; i < touch_data->TD_STATUS; i++)
+status_t FT5406_GetLatestMultiTouch(ft5406_handle_t *handle,
+                                    int *touch_count,
+                                    touch_point_t touch_array[FT5406_MAX_TOUCHES],
+                                    uint32_t *seq)
+{
+    uint32_t seq1, seq2;
+    int count;
+
+    assert(handle);
+
+    if (!handle)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    do
+    {
+        seq1 = handle->seq;
+        __sync_synchronize();
+
+        count = handle->touch_count;
+        memcpy(touch_array, handle->touch_array, sizeof(handle->touch_array));
+
+        __sync_synchronize();
+        seq2 = handle->seq;
+    } while ((seq1 & 1) || seq1 != seq2);
+
+    if (seq1 == 0)
+    {
+        return kStatus_Fail;
+    }
+
+    if (touch_count)
+    {
+        *touch_count = count;
+    }
+
+    if (seq)
+    {
+        *seq = seq1;
+    }
+
+    return kStatus_Success;
+}
+
+status_t FT5406_GetLatestSingleTouch(ft5406_handle_t *handle, touch_event_t *touch_event, int *touch_x, int *touch_y)
+{
+    status_t status;
+    touch_point_t touch_array[FT5406_MAX_TOUCHES];
+    touch_event_t touch_event_local;
+
+    status = FT5406_GetLatestMultiTouch(handle, NULL, touch_array, NULL);
+
+    if (status == kStatus_Success)
+    {
+        if (touch_event == NULL)
         {
-            touch_array[i].TOUCH_ID = TOUCH_POINT_GET_ID(touch_data->TOUCH[i]);
-            touch_array[i].TOUCH_EVENT = TOUCH_POINT_GET_EVENT(touch_data->TOUCH[i]);
-            touch_array[i].TOUCH_X = TOUCH_POINT_GET_X(touch_data->TOUCH[i]);
-            touch_array[i].TOUCH_Y = TOUCH_POINT_GET_Y(touch_data->TOUCH[i]);
+            touch_event = &touch_event_local;
         }
+        *touch_event = touch_array[0].TOUCH_EVENT;
 
-        /* Clear vacant elements of touch_array */
-        for (; i < FT5406_MAX_TOUCHES; i++)
+        /* Update coordinates only if there is touch detected */
+        if ((*touch_event == kTouch_Down) || (*touch_event == kTouch_Contact))
         {
-            touch_array[i].TOUCH_ID = 0;
-            touch_array[i].TOUCH_EVENT = kTouch_Reserved;
-            touch_array[i].TOUCH_X = 0;
-            touch_array[i].TOUCH_Y = 0;
+            if (touch_x)
+            {
+                *touch_x = touch_array[0].TOUCH_X;
+            }
+            if (touch_y)
+            {
+                *touch_y = touch_array[0].TOUCH_Y;
+            }
         }
     }
 
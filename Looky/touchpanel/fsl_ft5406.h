@@ -80,6 +80,15 @@ typedef struct _ft5406_handle
     I2C_Type *base;
     i2c_master_transfer_t xfer;
     uint8_t touch_buf[FT5406_TOUCH_DATA_LEN];
+
+    /* Asynchronous acquisition, the I2C completion callback decodes
+     * touch_buf into a snapshot guarded by a sequence counter, readers
+     * retry if the counter is odd or changes under them. */
+    i2c_master_handle_t i2c_handle;
+    volatile bool busy;
+    volatile uint32_t seq;
+    int touch_count;
+    touch_point_t touch_array[FT5406_MAX_TOUCHES];
 } ft5406_handle_t;
 
 status_t FT5406_Init(ft5406_handle_t *handle, I2C_Type *base);
@@ -90,4 +99,30 @@ status_t FT5406_GetSingleTouch(ft5406_handle_t *handle, touch_event_t *touch_eve
 
 status_t FT5406_GetMultiTouch(ft5406_handle_t *handle, int *touch_count, touch_point_t touch_array[FT5406_MAX_TOUCHES]);
 
+/*!
+ * @brief Starts a non-blocking read of the touch data.
+ *
+ * Safe to call from interrupt context. When the transfer completes the
+ * latest touch snapshot is updated. Returns kStatus_I2C_Busy if a read is
+ * already in flight.
+ */
+status_t FT5406_ReadTouchDataAsync(ft5406_handle_t *handle);
+
+/*!
+ * @brief Gets the latest touch snapshot without touching the bus.
+ *
+ * Never blocks. Returns kStatus_Fail if no read has completed yet. If seq
+ * is non-NULL it receives the snapshot's sequence number, which changes
+ * every time a new snapshot is published.
+ */
+status_t FT5406_GetLatestMultiTouch(ft5406_handle_t *handle,
+                                    int *touch_count,
+                                    touch_point_t touch_array[FT5406_MAX_TOUCHES],
+                                    uint32_t *seq);
+
+/*!
+ * @brief Same as FT5406_GetSingleTouch, but from the latest snapshot.
+ */
+status_t FT5406_GetLatestSingleTouch(ft5406_handle_t *handle, touch_event_t *touch_event, int *touch_x, int *touch_y);
+
 #endif
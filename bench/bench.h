@@ -0,0 +1,54 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * Tiny helpers for host-side microbenchmarks
+ *
+ * These are built with the host compiler (make bench), never with mbed,
+ * numbers are only good for comparing kernels against each other.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// cycle-ish counter, TSC on x86, nanoseconds everywhere else
+static inline uint64_t bench_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+#endif
+}
+
+static inline uint64_t bench_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+// keep the compiler from throwing away our work
+static inline void bench_clobber(void *p) {
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+// run f n times, return best-of cycles per call
+template <typename F>
+uint64_t bench_run(int n, F f) {
+    uint64_t best = (uint64_t)-1;
+    for (int i = 0; i < n; i++) {
+        uint64_t t = bench_cycles();
+        f();
+        t = bench_cycles() - t;
+        if (t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+#endif
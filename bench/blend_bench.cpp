@@ -0,0 +1,167 @@
+// Compare 3:3:2 blend table lookups against unpacking and multiplying,
+// and see what anti-aliased drawing costs next to plain drawing
+#include <string.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "blend.h"
+#include "Frame.h"
+
+#define W 480
+#define H 272
+#define N 50
+#define SHAPES 200
+
+// what blending costs without the table
+static void blend_pixels(uint8_t *dst, const uint8_t *src,
+        const uint8_t *a, int n) {
+    for (int i = 0; i < n; i++) {
+        int l = blend_level(a[i]);
+        dst[i] = (l == 0) ? dst[i]
+               : (l == BLEND_LEVELS) ? src[i]
+               : blend332_slow(src[i], dst[i], l);
+    }
+}
+
+static void blend_lut(const uint8_t *lut, uint8_t *dst, const uint8_t *src,
+        const uint8_t *a, int n) {
+    for (int i = 0; i < n; i++) {
+        dst[i] = blend332(lut, src[i], dst[i], a[i]);
+    }
+}
+
+// nothing outside the clip rect should be touched
+static bool outside(const uint8_t *buffer, const Frame &f) {
+    int x1 = f.x() + f.clipx();
+    int y1 = f.y() + f.clipy();
+    for (int i = 0; i < H; i++) {
+        for (int j = 0; j < W; j++) {
+            if (buffer[i*W + j] && !(j >= x1 && j < x1+f.clipw() &&
+                    i >= y1 && i < y1+f.cliph())) {
+                printf("drew outside at %d,%d!\n", j, i);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int main() {
+    uint8_t *lut = (uint8_t*)malloc(blend_size());
+    uint64_t t = bench_ns();
+    blend_init(lut);
+    t = bench_ns() - t;
+    printf("%-24s %10.3f ms %8u KiB\n", "blend_init",
+            (double)t / 1e6, (unsigned)(blend_size() / 1024));
+
+    // every entry matches the slow way, and the ends are dst/src
+    for (int l = 1; l < BLEND_LEVELS; l++) {
+        for (int s = 0; s < 256; s++) {
+            for (int d = 0; d < 256; d++) {
+                int a = (l << BLEND_SHIFT);
+                if (blend332(lut, s, d, a) != blend332_slow(s, d, l)) {
+                    printf("blend mismatch %02x over %02x at %d!\n",
+                            s, d, l);
+                    exit(1);
+                }
+            }
+        }
+    }
+    if (blend332(lut, 0xff, 0x00, 0) != 0x00 ||
+            blend332(lut, 0xff, 0x00, 255) != 0xff ||
+            blend332(lut, 0xe0, 0x03, 128) != blend332_slow(0xe0, 0x03,
+                BLEND_LEVELS/2)) {
+        printf("blend ends wrong!\n");
+        exit(1);
+    }
+
+    // per pixel blends over a frame
+    int n = W*H;
+    uint8_t *dst = (uint8_t*)malloc(n);
+    uint8_t *src = (uint8_t*)malloc(n);
+    uint8_t *a = (uint8_t*)malloc(n);
+    for (int i = 0; i < n; i++) {
+        dst[i] = rand();
+        src[i] = rand();
+        a[i] = rand();
+    }
+    uint64_t slow = bench_run(N, [&]{
+        blend_pixels(dst, src, a, n); bench_clobber(dst); });
+    uint64_t fast = bench_run(N, [&]{
+        blend_lut(lut, dst, src, a, n); bench_clobber(dst); });
+    printf("%-24s %10llu cycles %8.3f pixels/cycle\n", "unpack/multiply",
+            (unsigned long long)slow, (double)n / (double)(slow|1));
+    printf("%-24s %10llu cycles %8.3f pixels/cycle\n", "lut",
+            (unsigned long long)fast, (double)n / (double)(fast|1));
+
+    // anti-aliased shapes against their plain versions
+    uint64_t *buffer = (uint64_t*)malloc(W*H);
+    Frame f(buffer, W, H);
+    int xs[SHAPES], ys[SHAPES], rs[SHAPES];
+    for (int i = 0; i < SHAPES; i++) {
+        xs[i] = rand() % W;
+        ys[i] = rand() % H;
+        rs[i] = 8 + rand() % 56;
+    }
+
+    blend_settable(lut);
+    memset(buffer, 0, W*H);
+    uint64_t plain = bench_run(N, [&]{
+        for (int i = 0; i+1 < SHAPES; i++) {
+            f.putline(xs[i], ys[i], xs[i+1], ys[i+1], 0xff);
+        }
+        bench_clobber(buffer); });
+    uint64_t aa = bench_run(N, [&]{
+        for (int i = 0; i+1 < SHAPES; i++) {
+            f.putaaline(xs[i], ys[i], xs[i+1], ys[i+1], 0xff);
+        }
+        bench_clobber(buffer); });
+    printf("%-24s %10llu cycles\n", "putline",
+            (unsigned long long)plain);
+    printf("%-24s %10llu cycles %7.2fx\n", "putaaline",
+            (unsigned long long)aa, (double)aa / (double)(plain|1));
+
+    aa = bench_run(N, [&]{
+        for (int i = 0; i < SHAPES; i++) {
+            f.putaacircle(xs[i], ys[i], rs[i], 0xff);
+        }
+        bench_clobber(buffer); });
+    printf("%-24s %10llu cycles %8.0f cycles/circle\n", "putaacircle",
+            (unsigned long long)aa, (double)aa / SHAPES);
+    aa = bench_run(N, [&]{
+        for (int i = 0; i < SHAPES; i++) {
+            f.putaadisc(xs[i], ys[i], rs[i], 0xff);
+        }
+        bench_clobber(buffer); });
+    printf("%-24s %10llu cycles %8.0f cycles/disc\n", "putaadisc",
+            (unsigned long long)aa, (double)aa / SHAPES);
+
+    // anti-aliased drawing stays in the clip rect
+    Frame c(f, 100, 50, 120, 80);
+    memset(buffer, 0, W*H);
+    for (int i = 0; i+1 < SHAPES; i++) {
+        c.putaaline(xs[i]-100, ys[i]-50, xs[i+1]-100, ys[i+1]-50, 0xff);
+        c.putaacircle(xs[i]-100, ys[i]-50, rs[i], 0xff);
+        c.putaadisc(xs[i]-100, ys[i]-50, rs[i], 0xff);
+    }
+    if (outside((uint8_t*)buffer, c)) {
+        exit(1);
+    }
+
+    // discs are solid inside, and lines land exactly on their endpoints
+    memset(buffer, 0, W*H);
+    f.putaadisc(200, 100, 30, 0xff);
+    f.putaaline(10, 10, 300, 200, 0xff);
+    uint8_t *b = (uint8_t*)buffer;
+    if (b[100*W + 200] != 0xff || b[100*W + 229] != 0xff ||
+            b[71*W + 200] != 0xff || b[100*W + 232] != 0 ||
+            b[10*W + 10] != 0xff || b[200*W + 300] != 0xff) {
+        printf("aa shapes wrong!\n");
+        exit(1);
+    }
+
+    free(buffer);
+    free(a);
+    free(src);
+    free(dst);
+    free(lut);
+}
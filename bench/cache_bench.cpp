@@ -0,0 +1,184 @@
+// Check the write-back CacheBlockDevice against a plain HeapBlockDevice
+// under the same random reads, programs and erases, then see what each
+// policy costs in block device ops
+#include <string.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "CacheBlockDevice.h"
+#include "HeapBlockDevice.h"
+
+#define N 20
+#define OPS 20000
+
+// about the bench's SPI flash, shrunk down, with main's 8 KiB cache
+#define SIZE (64*1024)
+#define READ 1
+#define PROG 64
+#define ERASE 4096
+#define LINE 256
+#define CACHE (8*1024)
+
+// most io lands in a hot region, like a filesystem's metadata
+#define HOT (16*1024)
+#define MAX_IO 1024
+
+enum {
+    OP_READ,
+    OP_PROGRAM,
+    OP_ERASE,
+    OP_SYNC,
+};
+
+struct Op {
+    int type;
+    bd_addr_t addr;
+    bd_size_t size;
+};
+
+static Op ops[OPS];
+
+static void generate() {
+    for (int i = 0; i < OPS; i++) {
+        int r = rand() % 100;
+        Op &op = ops[i];
+        op.type = (r < 50) ? OP_READ
+                : (r < 95) ? OP_PROGRAM
+                : (r < 98) ? OP_ERASE
+                : OP_SYNC;
+
+        bd_addr_t region = (rand() % 4) ? HOT : SIZE;
+        if (op.type == OP_READ) {
+            op.size = 1 + rand() % MAX_IO;
+            op.addr = rand() % (region - op.size + 1);
+        } else if (op.type == OP_PROGRAM) {
+            op.size = PROG*(1 + rand() % (MAX_IO/PROG));
+            op.addr = PROG*(rand() % ((region - op.size)/PROG + 1));
+        } else if (op.type == OP_ERASE) {
+            op.size = ERASE;
+            op.addr = ERASE*(rand() % (region/ERASE));
+        }
+    }
+}
+
+// programs write something different every time
+static void fill(uint8_t *buffer, int i, bd_size_t size) {
+    for (bd_size_t j = 0; j < size; j++) {
+        buffer[j] = (uint8_t)(i*31 + j*7);
+    }
+}
+
+static int apply(BlockDevice &bd, int i, uint8_t *buffer) {
+    const Op &op = ops[i];
+    switch (op.type) {
+        case OP_READ:
+            return bd.read(buffer, op.addr, op.size);
+        case OP_PROGRAM:
+            fill(buffer, i, op.size);
+            return bd.program(buffer, op.addr, op.size);
+        case OP_ERASE:
+            return bd.erase(op.addr, op.size);
+        default:
+            return bd.sync();
+    }
+}
+
+// everything synced should have made it to the device underneath
+static bool same(HeapBlockDevice &a, HeapBlockDevice &b) {
+    static uint8_t x[SIZE];
+    static uint8_t y[SIZE];
+    a.read(x, 0, SIZE);
+    b.read(y, 0, SIZE);
+    return memcmp(x, y, SIZE) == 0;
+}
+
+static void check(int policy) {
+    HeapBlockDevice ref(SIZE, READ, PROG, ERASE);
+    HeapBlockDevice under(SIZE, READ, PROG, ERASE);
+    static uint64_t lines[CACHE/8];
+    CacheBlockDevice cache(&under, lines, CACHE, LINE, policy);
+    if (ref.init() || cache.init()) {
+        printf("%s init failed!\n", CacheBlockDevice::name(policy));
+        exit(1);
+    }
+
+    static uint8_t a[MAX_IO];
+    static uint8_t b[MAX_IO];
+    for (int i = 0; i < OPS; i++) {
+        int err = apply(ref, i, a);
+        int cerr = apply(cache, i, b);
+        if (err || cerr) {
+            printf("%s op %d failed %d != %d!\n",
+                    CacheBlockDevice::name(policy), i, cerr, err);
+            exit(1);
+        }
+
+        if (ops[i].type == OP_READ && memcmp(a, b, ops[i].size) != 0) {
+            printf("%s read mismatch at op %d, 0x%llx+%llu!\n",
+                    CacheBlockDevice::name(policy), i,
+                    (unsigned long long)ops[i].addr,
+                    (unsigned long long)ops[i].size);
+            exit(1);
+        }
+
+        if (ops[i].type == OP_SYNC && !same(ref, under)) {
+            printf("%s sync mismatch at op %d!\n",
+                    CacheBlockDevice::name(policy), i);
+            exit(1);
+        }
+    }
+
+    // writes underneath us show up once we drop our lines
+    fill(a, OPS, PROG);
+    if (cache.sync() || cache.read(b, 0, PROG) ||
+            ref.erase(0, ERASE) || ref.program(a, 0, PROG) ||
+            under.erase(0, ERASE) || under.program(a, 0, PROG) ||
+            cache.invalidate() || cache.read(b, 0, PROG) ||
+            memcmp(a, b, PROG) != 0) {
+        printf("%s invalidate mismatch!\n", CacheBlockDevice::name(policy));
+        exit(1);
+    }
+
+    // and deinit flushes whatever's left
+    if (cache.deinit() || !same(ref, under)) {
+        printf("%s deinit mismatch!\n", CacheBlockDevice::name(policy));
+        exit(1);
+    }
+
+    const CacheBlockDevice::Stats &s = cache.stats();
+    printf("%-8s %3u%% hits %8u reads -> %-8u %8u programs -> %-8u\n",
+            CacheBlockDevice::name(policy), (unsigned)s.hit_pct(),
+            (unsigned)s.reads, (unsigned)s.bd_reads,
+            (unsigned)s.programs, (unsigned)s.bd_programs);
+}
+
+static void timing(int policy) {
+    HeapBlockDevice under(SIZE, READ, PROG, ERASE);
+    static uint64_t lines[CACHE/8];
+    CacheBlockDevice cache(&under, lines, CACHE, LINE, policy);
+    cache.init();
+
+    static uint8_t buffer[MAX_IO];
+    printf("%-8s %10llu cycles\n", CacheBlockDevice::name(policy),
+            (unsigned long long)bench_run(N, [&]{
+                for (int i = 0; i < OPS; i++) {
+                    apply(cache, i, buffer);
+                }
+                cache.sync();
+                bench_clobber(buffer); }));
+    cache.deinit();
+}
+
+int main() {
+    srand(42);
+    generate();
+
+    // same data as the device on its own, for every policy
+    for (int policy = 0; policy < CACHE_POLICIES; policy++) {
+        check(policy);
+    }
+
+    // overheads only, everything's free on the heap
+    for (int policy = 0; policy < CACHE_POLICIES; policy++) {
+        timing(policy);
+    }
+}
@@ -0,0 +1,158 @@
+// Compare the SWAR fade kernel against the old per-byte Stars fade
+#include <string.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "fade.h"
+
+#define W 380
+#define H 272
+#define N 200
+
+// what Stars::fade used to do, ctr steps once per lit channel, red
+// then green then blue
+static int ctr;
+static uint8_t fade_byte(uint8_t p) {
+    int r = (p&0xe0) >> 5;
+    int g = (p&0x1c) >> 2;
+    int b = (p&0x03) >> 0;
+    r = r ? r-!((ctr++)&0x1) : 0;
+    g = g ? g-!((ctr++)&0x1) : 0;
+    b = b ? b-!((ctr++)&0x3) : 0;
+    return (r << 5) | (g << 2) | (b << 0);
+}
+
+// and what Stars::look used to do with it
+static void fade_bytes(uint8_t *dst, int stride, int w, int h) {
+    for (int y = 0; y < h; y++) {
+        uint8_t *row = &dst[y*stride];
+        int x = 0;
+        for (; x+8 <= w; x += 8) {
+            uint64_t x64;
+            memcpy(&x64, &row[x], sizeof(x64));
+            if (!x64) { continue; }
+
+            uint8_t *x8 = (uint8_t*)&x64;
+            for (int i = 0; i < 8; i++) {
+                x8[i] = fade_byte(x8[i]);
+            }
+
+            memcpy(&row[x], &x64, sizeof(x64));
+        }
+
+        for (; x < w; x++) {
+            row[x] = fade_byte(row[x]);
+        }
+    }
+}
+
+// scalar reference for a single saturating subtract
+static uint8_t fade_ref(uint8_t p, uint8_t d) {
+    int r = p >> 5, g = (p >> 2) & 7, b = p & 3;
+    r = (r > (d >> 5))     ? r - (d >> 5)     : 0;
+    g = (g > (d >> 2 & 7)) ? g - (d >> 2 & 7) : 0;
+    b = (b > (d & 3))      ? b - (d & 3)      : 0;
+    return (r << 5) | (g << 2) | b;
+}
+
+// fill a frame with lit pixels, roughly density of them
+static void scatter(uint8_t *frame, int stride, double density) {
+    memset(frame, 0, stride*H);
+    int n = (int)(density*W*H);
+    for (int i = 0; i < n; i++) {
+        frame[(rand() % H)*stride + rand() % W] = rand() | 1;
+    }
+}
+
+// fading is destructive, so restore the frame before each untimed run
+template <typename F>
+static uint64_t run(uint8_t *frame, const uint8_t *src, F f) {
+    uint64_t best = (uint64_t)-1;
+    for (int i = 0; i < N; i++) {
+        memcpy(frame, src, 480*H);
+        bench_clobber(frame);
+        uint64_t t = bench_cycles();
+        f();
+        bench_clobber(frame);
+        t = bench_cycles() - t;
+        if (t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+static void report(const char *name, double density, uint64_t cycles) {
+    printf("%-24s %5.1f%% lit %10llu cycles %8.3f bytes/cycle\n",
+            name, 100*density, (unsigned long long)cycles,
+            (double)(W*H) / (double)(cycles|1));
+}
+
+static void compare(uint8_t *frame, double density) {
+    uint8_t *src = (uint8_t*)malloc(480*H);
+    scatter(src, 480, density);
+
+    uint64_t dec = 0x0024002400240024ULL | 0x0000000100000001ULL;
+    size_t words = fade_occupancy_size(W, H);
+    uint32_t *lit = (uint32_t*)malloc(words*sizeof(uint32_t));
+
+    report("per-byte fade", density, run(frame, src, [&]{
+        fade_bytes(frame, 480, W, H); }));
+    report("faderect332", density, run(frame, src, [&]{
+        faderect332(frame, 480, W, H, dec, NULL); }));
+
+    // occupancy as Stars keeps it, built from the lit pixels
+    memset(lit, 0, words*sizeof(uint32_t));
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            if (src[y*480 + x]) {
+                fade_mark(lit, W, x, y);
+            }
+        }
+    }
+    uint32_t *scratch = (uint32_t*)malloc(words*sizeof(uint32_t));
+    report("faderect332+occupancy", density, run(frame, src, [&]{
+        memcpy(scratch, lit, words*sizeof(uint32_t));
+        faderect332(frame, 480, W, H, dec, scratch); }));
+
+    // sanity check, every pixel must match the scalar reference, and
+    // occupancy must not change the result
+    memcpy(frame, src, 480*H);
+    faderect332(frame, 480, W, H, dec, NULL);
+    uint8_t *ref = (uint8_t*)malloc(480*H);
+    memcpy(ref, frame, 480*H);
+    memcpy(frame, src, 480*H);
+    memcpy(scratch, lit, words*sizeof(uint32_t));
+    faderect332(frame, 480, W, H, dec, scratch);
+    for (int y = 0; y < H; y++) {
+        uint64_t d = dec;
+        for (int i = 0; i < y; i++) {
+            d = (d << 8) | (d >> 56);
+        }
+        for (int x = 0; x < W; x++) {
+            uint8_t want = fade_ref(src[y*480 + x], d >> 8*(x % 8));
+            if (ref[y*480 + x] != want || frame[y*480 + x] != want) {
+                printf("faderect332 mismatch at %d,%d!\n", x, y);
+                exit(1);
+            }
+        }
+    }
+
+    free(ref);
+    free(scratch);
+    free(lit);
+    free(src);
+}
+
+int main() {
+    // frame buffers from sdram_alloc are always 64-bit aligned
+    uint64_t *frame = (uint64_t*)calloc(480*H/8, sizeof(uint64_t));
+    uint8_t *f8 = (uint8_t*)frame;
+
+    // a few stars, a busy sky, and everything lit
+    compare(f8, 0.001);
+    compare(f8, 0.05);
+    compare(f8, 1.0);
+
+    free(frame);
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Compare the word-wide fill kernels against the old memset-per-row path
+#include <string.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "fill.h"
+#include "Format.h"
+
+#define W 480
+#define H 272
+#define N 200
+
+// what Frame::putrect used to do
+static void putrect_memset(uint8_t *dst, int stride, int w, int h, uint8_t p) {
+    for (int i = 0; i < h; i++) {
+        memset(&dst[i*stride], p, w);
+    }
+}
+
+// plain bytewise loop, roughly what a small memset does on target
+static void putrect_bytes(uint8_t *dst, int stride, int w, int h, uint8_t p) {
+    for (int i = 0; i < h; i++) {
+        volatile uint8_t *row = &dst[i*stride];
+        for (int j = 0; j < w; j++) {
+            row[j] = p;
+        }
+    }
+}
+
+static void report(const char *name, int w, int h, uint64_t cycles) {
+    printf("%-24s %3dx%-3d %10llu cycles %8.3f bytes/cycle\n",
+            name, w, h, (unsigned long long)cycles,
+            (double)(w*h) / (double)(cycles|1));
+}
+
+static void compare(uint8_t *frame, int x, int y, int w, int h) {
+    uint8_t *dst = &frame[x + y*W];
+    report("memset rows", w, h, bench_run(N, [&]{
+        putrect_memset(dst, W, w, h, 0x25); bench_clobber(frame); }));
+    report("byte rows", w, h, bench_run(N, [&]{
+        putrect_bytes(dst, W, w, h, 0x25); bench_clobber(frame); }));
+    report("fillrect8", w, h, bench_run(N, [&]{
+        fillrect8(dst, W, w, h, 0x25); bench_clobber(frame); }));
+
+    // sanity check, kernels must agree
+    putrect_memset(dst, W, w, h, 0x5a);
+    uint8_t *ref = (uint8_t*)malloc(W*H);
+    memcpy(ref, frame, W*H);
+    putrect_memset(dst, W, w, h, 0x00);
+    fillrect8(dst, W, w, h, 0x5a);
+    if (memcmp(ref, frame, W*H) != 0) {
+        printf("fillrect8 mismatch at %d,%d %dx%d!\n", x, y, w, h);
+        exit(1);
+    }
+    free(ref);
+}
+
+// what a generic Frame would do for any format, a pixel at a time
+template <typename F>
+static void fill_pixels(uint8_t *frame, int stride, int x, int w, int h,
+        typename F::pixel_t p) {
+    for (int i = 0; i < h; i++) {
+        for (int j = 0; j < w; j++) {
+            F::put(&frame[i*stride], x+j, p);
+        }
+    }
+}
+
+template <typename F>
+static void compare_format(const char *name, uint8_t *frame,
+        int x, int y, int w, int h) {
+    int stride = W*F::BPP/8;
+    uint8_t *row = &frame[y*stride];
+    typename F::pixel_t p = (typename F::pixel_t)0x5a5a;
+    char line[64];
+    int bytes = (w*F::BPP + 7)/8;
+
+    snprintf(line, sizeof(line), "%s per-pixel", name);
+    printf("%-24s %3dx%-3d %10llu cycles\n", line, w, h,
+            (unsigned long long)bench_run(N, [&]{
+                fill_pixels<F>(row, stride, x, w, h, p);
+                bench_clobber(frame); }));
+    snprintf(line, sizeof(line), "%s fill", name);
+    uint64_t fill = bench_run(N, [&]{
+        F::fill(row, stride, x, w, h, p); bench_clobber(frame); });
+    printf("%-24s %3dx%-3d %10llu cycles %8.3f bytes/cycle\n", line, w, h,
+            (unsigned long long)fill, (double)(bytes*h) / (double)(fill|1));
+
+    // fill and copy must agree with the pixel at a time versions, and
+    // leave their neighbors alone
+    uint8_t *ref = (uint8_t*)malloc(stride*H);
+    uint8_t *src = (uint8_t*)malloc(stride*H);
+    for (int i = 0; i < stride*H; i++) {
+        src[i] = rand();
+    }
+    memcpy(frame, src, stride*H);
+    fill_pixels<F>(row, stride, x, w, h, p);
+    memcpy(ref, frame, stride*H);
+    memcpy(frame, src, stride*H);
+    F::fill(row, stride, x, w, h, p);
+    if (memcmp(ref, frame, stride*H) != 0) {
+        printf("%s fill mismatch at %d,%d %dx%d!\n", name, x, y, w, h);
+        exit(1);
+    }
+
+    memset(frame, 0, stride*H);
+    memset(ref, 0, stride*H);
+    for (int i = 0; i < h; i++) {
+        for (int j = 0; j < w; j++) {
+            F::put(&ref[(y+i)*stride], x+j, F::get(&src[(y+i)*stride], x+j));
+        }
+    }
+    F::copy(row, &src[y*stride], stride, x, w, h);
+    if (memcmp(ref, frame, stride*H) != 0) {
+        printf("%s copy mismatch at %d,%d %dx%d!\n", name, x, y, w, h);
+        exit(1);
+    }
+
+    free(src);
+    free(ref);
+}
+
+template <typename F>
+static void compare_format(const char *name, uint8_t *frame) {
+    compare_format<F>(name, frame, 0, 0, W, H);
+    compare_format<F>(name, frame, 381, 0, W-381, H);
+    compare_format<F>(name, frame, 383, 40, 79, 14);
+    compare_format<F>(name, frame, 3, 5, 1, 9);
+}
+
+int main() {
+    // frame buffers from sdram_alloc are always 64-bit aligned
+    uint64_t *frame = (uint64_t*)calloc(W*H/8, sizeof(uint64_t));
+    uint8_t *f8 = (uint8_t*)frame;
+
+    // full back buffer clear
+    compare(f8, 0, 0, W, H);
+    // the console/effects slice
+    compare(f8, 0, 0, 380, H);
+    // the GUI slice, unaligned head
+    compare(f8, 381, 0, W-381, H);
+    // a button highlight, unaligned and short
+    compare(f8, 383, 40, 79, 14);
+
+    // and the other formats Frame can be
+    compare_format<Format1>("1-bit", f8);
+    compare_format<Format2>("2-bit", f8);
+    compare_format<Format4>("4-bit", f8);
+    uint8_t *f16 = (uint8_t*)calloc(W*H, 2);
+    compare_format<Format565>("16-bit", f16);
+    free(f16);
+
+    free(frame);
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Compare Frame::putp against the fixed stride FrameView policies
+#include <string.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "Frame.h"
+#include "FrameView.h"
+
+#define W 480
+#define H 272
+#define N 200
+#define POINTS 4000     // about what Rain draws a frame
+#define LINES 64
+
+static int xs[POINTS];
+static int ys[POINTS];
+
+// nothing outside the slice at x1/y1 w x h should be drawn
+static bool outside(const uint64_t *buffer, int x1, int y1, int w, int h) {
+    for (int i = 0; i < H; i++) {
+        for (int j = 0; j < W; j++) {
+            if (((const uint8_t*)buffer)[i*W + j] &&
+                    !(j >= x1 && j < x1+w && i >= y1 && i < y1+h)) {
+                printf("drew outside at %d,%d!\n", j, i);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void points(const Frame &f) {
+    for (int i = 0; i < POINTS; i++) {
+        f.putp(xs[i], ys[i], i);
+    }
+}
+
+template <typename V>
+static void points(const V &v) {
+    for (int i = 0; i < POINTS; i++) {
+        v.putp(xs[i], ys[i], i);
+    }
+}
+
+static void lines(const Frame &f) {
+    for (int i = 0; i+1 < LINES; i++) {
+        f.putline(xs[i], ys[i], xs[i+1], ys[i+1], i);
+    }
+}
+
+template <typename V>
+static void lines(const V &v) {
+    for (int i = 0; i+1 < LINES; i++) {
+        v.putline(xs[i], ys[i], xs[i+1], ys[i+1], i);
+    }
+}
+
+template <typename V>
+static void compare(const char *name, const Frame &f, uint64_t *ref) {
+    V v(f);
+    uint8_t *buffer = f.buffer(-f.x(), -f.y());
+
+    memset(buffer, 0, W*H);
+    printf("%-24s %10llu cycles\n", name,
+            (unsigned long long)bench_run(N, [&]{
+                points(v); bench_clobber(buffer); }));
+    if (memcmp(buffer, ref, W*H) != 0) {
+        printf("%s points mismatch!\n", name);
+        exit(1);
+    }
+
+    // putline draws each endpoint once, so only check what's lit
+    memset(buffer, 0, W*H);
+    printf("%-24s %10llu cycles\n", "  putline",
+            (unsigned long long)bench_run(N, [&]{
+                lines(v); bench_clobber(buffer); }));
+    memset(buffer, 0, W*H);
+    lines(v);
+    uint8_t *lit = (uint8_t*)malloc(W*H);
+    memcpy(lit, buffer, W*H);
+    memset(buffer, 0, W*H);
+    lines(f);
+    for (int i = 0; i < W*H; i++) {
+        if (!lit[i] != !buffer[i]) {
+            printf("%s lines mismatch at %d,%d!\n", name, i % W, i / W);
+            exit(1);
+        }
+    }
+    free(lit);
+}
+
+int main() {
+    uint64_t *buffer = (uint64_t*)malloc(W*H);
+    uint64_t *ref = (uint64_t*)malloc(W*H);
+    Frame lcd(buffer, W, H);
+    // where Rain and Stars draw
+    Frame f(lcd, 0, 0, 380, H);
+
+    srand(42);
+    for (int i = 0; i < POINTS; i++) {
+        xs[i] = rand() % f.w();
+        ys[i] = rand() % f.h();
+    }
+
+    memset(buffer, 0, W*H);
+    printf("%-24s %10llu cycles\n", "Frame::putp",
+            (unsigned long long)bench_run(N, [&]{
+                points(f); bench_clobber(buffer); }));
+    memcpy(ref, buffer, W*H);
+    printf("%-24s %10llu cycles\n", "  putline",
+            (unsigned long long)bench_run(N, [&]{
+                lines(f); bench_clobber(buffer); }));
+
+    compare<FrameView<Format332, W, H, FrameChecked> >(
+            "FrameView checked", f, ref);
+    compare<FrameView<Format332, W, H, FrameClipped> >(
+            "FrameView clipped", f, ref);
+    compare<FrameView<Format332, W, H, FrameUnchecked> >(
+            "FrameView unchecked", f, ref);
+
+    // clipped views quietly drop anything off the edge
+    FrameView<Format332, W, H, FrameClipped> v(f);
+    memset(buffer, 0, W*H);
+    v.putp(-1, 0, 0xff);
+    v.putp(f.w(), 0, 0xff);
+    v.putp(0, f.h(), 0xff);
+    v.putline(-20, -20, f.w()+20, f.h()+20, 0xff);
+    if (outside(buffer, 0, 0, f.w(), H)) {
+        exit(1);
+    }
+
+    // lines mostly off a small clip rect, Frame and the clipped view both
+    // clip these once up front
+    Frame c(f, 100, 50, 120, 80);
+    FrameView<Format332, W, H, FrameClipped> cv(c);
+    for (int i = 0; i < LINES; i++) {
+        xs[i] = rand() % 2000 - 1000;
+        ys[i] = rand() % 2000 - 1000;
+    }
+
+    memset(buffer, 0, W*H);
+    printf("%-24s %10llu cycles\n", "clipped Frame::putline",
+            (unsigned long long)bench_run(N, [&]{
+                lines(c); bench_clobber(buffer); }));
+    if (outside(buffer, 100, 50, 120, 80)) {
+        exit(1);
+    }
+    memset(buffer, 0, W*H);
+    printf("%-24s %10llu cycles\n", "clipped view putline",
+            (unsigned long long)bench_run(N, [&]{
+                lines(cv); bench_clobber(buffer); }));
+
+    // and nested clip rects only ever shrink
+    Frame n(c, -10, -10, 50, 50);
+    n.setclip(20, 20, 100, 100);
+    memset(buffer, 0, W*H);
+    n.clear(0xff);
+    n.putrect(-50, -50, 500, 500, 0xff);
+    n.putline(-50, 30, 500, 30, 0xff);
+    n.putp(-5, 25, 0xff);
+    n.puts(15, 21, "clip", 0xff);
+    if (outside(buffer, 110, 60, 30, 30)) {
+        exit(1);
+    }
+    if (((uint8_t*)buffer)[60*W + 110] != 0xff ||
+            ((uint8_t*)buffer)[89*W + 139] != 0xff) {
+        printf("nested clip didn't fill its clip rect!\n");
+        exit(1);
+    }
+
+    free(ref);
+    free(buffer);
+}
@@ -0,0 +1,153 @@
+// Decode the splash screen from its compressed image, against blitting
+// the 1-bit BMP it came from a pixel at a time
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+#include "bench.h"
+#include "image.h"
+#include "rle.h"
+#include "../images/splash.h"
+
+#define N 200
+
+// what blitting a 1-bit BMP straight out of flash looks like
+static void bmp_blit(uint8_t *dst, int stride, const uint8_t *bmp) {
+    uint32_t data; int32_t w, h;
+    memcpy(&data, &bmp[10], 4);
+    memcpy(&w, &bmp[18], 4);
+    memcpy(&h, &bmp[22], 4);
+    const uint8_t *pal = &bmp[54];
+    int bmpstride = (w + 31) / 32 * 4;
+    for (int y = 0; y < h; y++) {
+        const uint8_t *row = &bmp[data + (h-1-y)*bmpstride];
+        for (int x = 0; x < w; x++) {
+            const uint8_t *c = &pal[4*((row[x/8] >> (7 - x%8)) & 1)];
+            dst[y*stride + x] = (c[2] & 0xe0) | ((c[1] & 0xe0) >> 3) |
+                    ((c[0] & 0xc0) >> 6);
+        }
+    }
+}
+
+// a made up image, every bpp and coding, checked through random windows
+static void roundtrip(int bpp, int flags) {
+    int w = 61, h = 23;
+    int colors = 1 << bpp;
+    int ppb = 8 / bpp;
+    int rowbytes = (w + ppb-1) / ppb;
+
+    std::vector<uint8_t> index(w*h), rows(rowbytes*h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            // blocky so RLE has something to find
+            int i = ((x/5) ^ (y/3)) % colors;
+            index[y*w + x] = i;
+            rows[y*rowbytes + x/ppb] |= i << (8 - bpp*(x%ppb + 1));
+        }
+    }
+
+    std::vector<uint8_t> coded = rows;
+    if (flags & IMAGE_XOR) {
+        for (int i = rowbytes*h-1; i >= rowbytes; i--) {
+            coded[i] ^= rows[i - rowbytes];
+        }
+    }
+    if (flags & IMAGE_RLE) {
+        std::vector<uint8_t> rle(rle_bound(coded.size()));
+        rle.resize(rle_encode(&rle[0], &coded[0], coded.size()));
+        coded = rle;
+    }
+
+    ImageHeader hdr = {IMAGE_MAGIC, (uint16_t)w, (uint16_t)h,
+            (uint8_t)bpp, (uint8_t)flags, (uint16_t)colors};
+    std::vector<uint8_t> img((uint8_t*)&hdr, (uint8_t*)(&hdr+1));
+    for (int i = 0; i < colors; i++) {
+        img.push_back(0x80 | i);
+    }
+    img.insert(img.end(), coded.begin(), coded.end());
+
+    uint8_t frame[80*40];
+    for (int i = 0; i < 500; i++) {
+        int sx = rand() % (w+10) - 5, sy = rand() % (h+10) - 5;
+        int ww = rand() % 70, hh = rand() % 30;
+        memset(frame, 0x5a, sizeof(frame));
+        if (image_decoderect(frame, 80, sx, sy, ww, hh,
+                &img[0], img.size())) {
+            printf("%d-bit flags %d: image_decoderect failed!\n", bpp, flags);
+            exit(1);
+        }
+
+        for (int y = 0; y < hh && y < 40; y++) {
+            for (int x = 0; x < ww && x < 80; x++) {
+                int ix = sx + x, iy = sy + y;
+                uint8_t want = (ix >= 0 && ix < w && iy >= 0 && iy < h)
+                        ? 0x80 | index[iy*w + ix] : 0x5a;
+                if (frame[y*80 + x] != want) {
+                    printf("%d-bit flags %d: mismatch at %d,%d in "
+                            "%d,%d %dx%d!\n", bpp, flags, x, y,
+                            sx, sy, ww, hh);
+                    exit(1);
+                }
+            }
+        }
+    }
+
+    // and truncated images have to be caught
+    if (image_decoderect(frame, 80, 0, 0, w, h, &img[0], img.size()-1) !=
+            -1 && (flags & IMAGE_RLE)) {
+        printf("%d-bit flags %d: missed a truncated image!\n", bpp, flags);
+        exit(1);
+    }
+}
+
+int main() {
+    static const int bpps[] = {1, 2, 4, 8};
+    static const int flags[] = {0, IMAGE_RLE, IMAGE_RLE | IMAGE_XOR};
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 3; j++) {
+            roundtrip(bpps[i], flags[j]);
+        }
+    }
+
+    FILE *f = fopen("images/splash.bmp", "rb");
+    if (!f) {
+        printf("run from the top of the repo, need images/splash.bmp\n");
+        return 1;
+    }
+    std::vector<uint8_t> bmp(1 << 16);
+    bmp.resize(fread(&bmp[0], 1, bmp.size(), f));
+    fclose(f);
+
+    ImageHeader hdr;
+    image_info(&hdr, splash_image, sizeof(splash_image));
+    uint8_t *a = (uint8_t*)calloc(480*272, 1);
+    uint8_t *b = (uint8_t*)calloc(480*272, 1);
+    bmp_blit(a, 480, &bmp[0]);
+    image_decoderect(b, 480, 0, 0, hdr.w, hdr.h,
+            splash_image, sizeof(splash_image));
+    if (memcmp(a, b, 480*272) != 0) {
+        printf("splash doesn't match its BMP!\n");
+        return 1;
+    }
+
+    uint64_t raw = bench_run(N, [&]{
+        bmp_blit(a, 480, &bmp[0]);
+        bench_clobber(a);
+    });
+    uint64_t dec = bench_run(N, [&]{
+        image_decoderect(b, 480, 0, 0, hdr.w, hdr.h,
+                splash_image, sizeof(splash_image));
+        bench_clobber(b);
+    });
+
+    printf("%-20s %6d bytes %10llu cycles\n", "1-bit bmp blit",
+            (int)bmp.size(), (unsigned long long)raw);
+    printf("%-20s %6d bytes %10llu cycles %5.1fx smaller %5.1fx faster\n",
+            "image_decoderect", (int)sizeof(splash_image),
+            (unsigned long long)dec,
+            (double)bmp.size() / sizeof(splash_image),
+            (double)raw / (double)(dec|1));
+
+    free(a);
+    free(b);
+    return 0;
+}
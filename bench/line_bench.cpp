@@ -0,0 +1,150 @@
+// Compare the pointer-stepping Frame::putline against the old per-pixel
+// Bresenham loop, in lines/ms by length and slope
+#include <string.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "Frame.h"
+
+#define W 480
+#define H 272
+#define N 20
+#define LINES 1000
+
+// what Frame::putline used to do
+static void putline_pixels(const Frame &f,
+        int x1, int y1, int x2, int y2, uint8_t p) {
+    int dx = (x1 < x2) ? x2-x1 : x1-x2;
+    int dy = (y1 < y2) ? y2-y1 : y1-y2;
+    int sx = (x1 < x2) ? 1 : -1;
+    int sy = (y1 < y2) ? 1 : -1;
+    int err = dx - dy;
+
+    while (true) {
+        f.putp(x1, y1, p);
+
+        int err2 = 2*err;
+
+        if (x1 == x2 && y1 == y2) {
+            break;
+        }
+
+        if (err2 > -dy) {
+            err -= dy;
+            x1 += sx;
+        }
+
+        if (x1 == x2 && y1 == y2) {
+            break;
+        }
+
+        if (err2 < dx) {
+            err += dx;
+            y1 += sy;
+        }
+    }
+
+    f.putp(x2, y2, p);
+}
+
+struct Line {
+    int x1, y1, x2, y2;
+};
+
+static Line lines[LINES];
+
+// random lines with the given run/rise, all directions, all in bounds
+static void generate(int rx, int ry) {
+    for (int i = 0; i < LINES; i++) {
+        int x = rand() % (W - rx);
+        int y = rand() % (H - ry);
+        bool flipx = rand() & 1;
+        bool flipy = rand() & 1;
+        lines[i].x1 = flipx ? x+rx : x;
+        lines[i].x2 = flipx ? x : x+rx;
+        lines[i].y1 = flipy ? y+ry : y;
+        lines[i].y2 = flipy ? y : y+ry;
+    }
+}
+
+template <typename D>
+static double lines_per_ms(uint8_t *buffer, D draw) {
+    uint64_t best = (uint64_t)-1;
+    for (int i = 0; i < N; i++) {
+        uint64_t t = bench_ns();
+        for (int j = 0; j < LINES; j++) {
+            draw(lines[j]);
+        }
+        bench_clobber(buffer);
+        t = bench_ns() - t;
+        if (t < best) {
+            best = t;
+        }
+    }
+    return (double)LINES*1000000.0 / (double)(best|1);
+}
+
+int main() {
+    uint64_t *buffer = (uint64_t*)malloc(W*H);
+    uint8_t *ref = (uint8_t*)malloc(W*H);
+    Frame f(buffer, W, H);
+
+    // same pixels as the old loop, in every direction and slope, these
+    // stay in bounds since clipping first can pick different pixels
+    srand(42);
+    for (int i = 0; i < 10000; i++) {
+        int x1 = rand() % W, y1 = rand() % H;
+        int x2 = rand() % W, y2 = rand() % H;
+        if (i % 4 == 0) {
+            // short lines hit the ties more often
+            x2 = x1 + rand() % 9 - 4;
+            y2 = y1 + rand() % 9 - 4;
+            x2 = (x2 < 0) ? 0 : (x2 >= W) ? W-1 : x2;
+            y2 = (y2 < 0) ? 0 : (y2 >= H) ? H-1 : y2;
+        }
+
+        memset(buffer, 0, W*H);
+        putline_pixels(f, x1, y1, x2, y2, 0xff);
+        memcpy(ref, buffer, W*H);
+        memset(buffer, 0, W*H);
+        f.putline(x1, y1, x2, y2, 0xff);
+        if (memcmp(ref, buffer, W*H) != 0) {
+            printf("putline mismatch %d,%d -> %d,%d!\n", x1, y1, x2, y2);
+            exit(1);
+        }
+    }
+
+    static const struct {
+        const char *name;
+        int rx, ry;     // per unit of length
+    } slopes[] = {
+        {"horizontal", 1, 0},
+        {"vertical",   0, 1},
+        {"diagonal",   1, 1},
+        {"shallow",    4, 1},
+        {"steep",      1, 4},
+    };
+    static const int lengths[] = {4, 16, 64, 256};
+
+    printf("%-12s %6s %14s %14s %8s\n",
+            "slope", "length", "putp lines/ms", "lines/ms", "speedup");
+    for (unsigned i = 0; i < sizeof(slopes)/sizeof(slopes[0]); i++) {
+        for (unsigned j = 0; j < sizeof(lengths)/sizeof(lengths[0]); j++) {
+            // length along the major axis
+            int m = (slopes[i].rx > slopes[i].ry) ? slopes[i].rx
+                                                  : slopes[i].ry;
+            int rx = slopes[i].rx*lengths[j]/m;
+            int ry = slopes[i].ry*lengths[j]/m;
+            generate(rx, ry);
+
+            double old = lines_per_ms((uint8_t*)buffer, [&](const Line &l) {
+                putline_pixels(f, l.x1, l.y1, l.x2, l.y2, 0xff); });
+            double now = lines_per_ms((uint8_t*)buffer, [&](const Line &l) {
+                f.putline(l.x1, l.y1, l.x2, l.y2, 0xff); });
+            printf("%-12s %6d %14.0f %14.0f %7.2fx\n",
+                    slopes[i].name, lengths[j], old, now, now/old);
+        }
+    }
+
+    free(ref);
+    free(buffer);
+}
@@ -0,0 +1,169 @@
+// Particles/ms for the SoA particle engine vs Rain's old array of structs
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "Particles.h"
+
+#define W 380
+#define H 272
+#define N 50
+
+// the old way skips dead drops, so start them high enough that none hit
+// the ground in the 2*N updates we time, at up to 1000 down plus 10 more
+// per update
+#define SKY (2*N*(1000 + 10*2*N))
+
+// what Rain used to do, minus the drawing
+struct drop {int x; int y; int vx; int vy;};
+
+static void aos_update(struct drop *drops, int count) {
+    for (int i = 0; i < count; i++) {
+        if (drops[i].y <= 0) {
+            continue;
+        }
+
+        drops[i].x += drops[i].vx;
+        drops[i].y += drops[i].vy;
+        drops[i].vy -= 10;
+        drops[i].vx = drops[i].vx - drops[i].vx/100;
+        drops[i].vy = drops[i].vy - drops[i].vy/100;
+    }
+}
+
+static int aos_touch(struct drop *drops, int count, int x, int y) {
+    int hits = 0;
+    for (int i = 0; i < count; i++) {
+        int dx = (drops[i].x/1000)-(x/1000);
+        int dy = (drops[i].y/1000)-(y/1000);
+        if (dx*dx + dy*dy > 1000) { continue; }
+        hits += 1;
+    }
+    return hits;
+}
+
+struct Count {
+    int hits;
+    Count() : hits(0) {}
+    void operator()(int i) { hits += 1; }
+};
+
+static double per_ms(int count, uint64_t ns) {
+    return (double)count / ((double)ns / 1e6);
+}
+
+static void compare(int count) {
+    // old way
+    struct drop *drops = (struct drop*)malloc(count*sizeof(struct drop));
+    for (int i = 0; i < count; i++) {
+        drops[i].x = (rand() % W)*1000;
+        drops[i].y = (rand() % H + 1)*1000 + SKY;
+        drops[i].vx = rand() % 200 - 100;
+        drops[i].vy = -(rand() % 1000);
+    }
+
+    uint64_t aos = bench_run(N, [&]{
+        aos_update(drops, count); bench_clobber(drops); });
+    uint64_t aos_q = bench_run(N, [&]{
+        bench_clobber((void*)(intptr_t)aos_touch(drops, count,
+                W/2*1000, H/2*1000 + SKY)); });
+
+    // new way, floor way down so nothing dies mid-benchmark
+    Particles p;
+    void *buffer = malloc(Particles::footprint(count, W, H));
+    p.init(buffer, count, W, H);
+    p.gravity = 10;
+    p.damping = (99 << 16) / 100;
+    p.floor = 0x7fffffff;
+    for (int i = 0; i < count; i++) {
+        p.emit((rand() % W) << Particles::SHIFT,
+               (rand() % H) << Particles::SHIFT,
+               rand() % 200 - 100, rand() % 1000);
+    }
+
+    uint64_t soa = bench_run(N, [&]{ p.update(); bench_clobber(p.x); });
+    uint64_t soa_i = bench_run(N, [&]{
+        p.update(); p.index(); bench_clobber(p.x); }) - soa;
+    uint64_t soa_q = bench_run(N, [&]{
+        Count c; p.index(); p.query(W/2, H/2, 32, c);
+        bench_clobber((void*)(intptr_t)c.hits); });
+
+    // bench_cycles is only ns off x86, time it properly for the report
+    uint64_t t = bench_ns();
+    for (int i = 0; i < N; i++) { aos_update(drops, count); }
+    uint64_t aos_ns = (bench_ns() - t) / N;
+    bench_clobber(drops);
+    t = bench_ns();
+    for (int i = 0; i < N; i++) { p.update(); }
+    uint64_t soa_ns = (bench_ns() - t) / N;
+
+    for (int i = 0; i < count; i++) {
+        if (drops[i].y <= 0) {
+            printf("aos drop %d died mid-benchmark!\n", i);
+            exit(1);
+        }
+    }
+
+    printf("%6d particles\n", count);
+    printf("  %-22s %10llu cycles %12.0f particles/ms\n", "aos update",
+            (unsigned long long)aos, per_ms(count, aos_ns));
+    printf("  %-22s %10llu cycles %12.0f particles/ms\n", "soa update",
+            (unsigned long long)soa, per_ms(count, soa_ns));
+    printf("  %-22s %10llu cycles\n", "soa grid rebuild",
+            (unsigned long long)soa_i);
+    printf("  %-22s %10llu cycles\n", "aos touch scan",
+            (unsigned long long)aos_q);
+    printf("  %-22s %10llu cycles\n", "soa touch query",
+            (unsigned long long)soa_q);
+
+    free(drops);
+    free(buffer);
+}
+
+int main() {
+    // sanity check the grid against a brute force scan
+    Particles p;
+    void *buffer = malloc(Particles::footprint(1100, W, H));
+    p.init(buffer, 1100, W, H);
+    for (int i = 0; i < 1000; i++) {
+        p.emit((rand() % W) << Particles::SHIFT,
+               (rand() % H) << Particles::SHIFT, 0, 0);
+    }
+    // and a few off the grid, these get binned into its edge cells
+    for (int i = 0; i < 50; i++) {
+        p.emit((-300 + rand() % 40) << Particles::SHIFT,
+               (-300 + rand() % 40) << Particles::SHIFT, 0, 0);
+        p.emit((W+300 + rand() % 40) << Particles::SHIFT,
+               (H/2 + rand() % 40) << Particles::SHIFT, 0, 0);
+    }
+    p.update();
+    p.index();
+    // including queries hanging off, or entirely off, the grid
+    static const int centers[][2] = {
+        {100, 100}, {-20, 10}, {W+10, H/2}, {-300, -300}, {W+300, H/2},
+    };
+    for (unsigned j = 0; j < sizeof(centers)/sizeof(centers[0]); j++) {
+        int qx = centers[j][0];
+        int qy = centers[j][1];
+        for (int r = 1; r < 100; r += 7) {
+            Count c;
+            p.query(qx, qy, r, c);
+            int brute = 0;
+            for (int i = 0; i < p.count(); i++) {
+                int dx = (p.x[i] >> Particles::SHIFT) - qx;
+                int dy = (p.y[i] >> Particles::SHIFT) - qy;
+                brute += (dx*dx + dy*dy <= r*r);
+            }
+            if (c.hits != brute) {
+                printf("grid query mismatch %d,%d r=%d %d != %d\n",
+                        qx, qy, r, c.hits, brute);
+                return 1;
+            }
+        }
+    }
+    free(buffer);
+
+    compare(500);
+    compare(10000);
+    compare(50000);
+    return 0;
+}
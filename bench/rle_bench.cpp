@@ -0,0 +1,92 @@
+// Round-trip the RLE kernels and measure decode throughput into a frame
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bench.h"
+#include "rle.h"
+
+#define W 380
+#define H 272
+#define N 200
+
+// flat bands, what rendered animations mostly look like
+static void bands(uint8_t *frame, int stride, int t) {
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            int dx = x - W/2, dy = y - H/2;
+            int r = (int)sqrtf((float)(dx*dx + dy*dy));
+            frame[y*stride + x] = ((r + t) / 12) & 1 ? 0xe0 + (r/40 << 2) : 0;
+        }
+    }
+}
+
+// noise, the worst case for RLE
+static void noise(uint8_t *frame, int stride, int) {
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            frame[y*stride + x] = rand();
+        }
+    }
+}
+
+static void compare(const char *name, void (*gen)(uint8_t*, int, int)) {
+    uint8_t *src = (uint8_t*)calloc(480*H, 1);
+    uint8_t *frame = (uint8_t*)calloc(480*H, 1);
+    uint8_t *enc = (uint8_t*)malloc(rle_bound(W*H));
+    gen(src, 480, 7);
+
+    size_t size = rle_encoderect(enc, src, 480, W, H);
+    if (size > rle_bound(W*H)) {
+        printf("%s: rle_encoderect overran its bound!\n", name);
+        exit(1);
+    }
+
+    // decode must reproduce the rect, use all of the input, and leave
+    // the stride padding alone
+    memset(frame, 0x5a, 480*H);
+    int used = rle_decoderect(frame, 480, W, H, enc, size);
+    for (int y = 0; y < H; y++) {
+        if (memcmp(&frame[y*480], &src[y*480], W) != 0 ||
+                frame[y*480 + W] != 0x5a) {
+            printf("%s: rle_decoderect mismatch in row %d!\n", name, y);
+            exit(1);
+        }
+    }
+    if (used != (int)size) {
+        printf("%s: rle_decoderect used %d of %d bytes!\n",
+                name, used, (int)size);
+        exit(1);
+    }
+    if (size > 0 && rle_decoderect(frame, 480, W, H, enc, size-1) != -1) {
+        printf("%s: rle_decoderect missed a short input!\n", name);
+        exit(1);
+    }
+
+    uint64_t copy = bench_run(N, [&]{
+        for (int y = 0; y < H; y++) {
+            memcpy(&frame[y*480], &src[y*480], W);
+        }
+        bench_clobber(frame);
+    });
+    uint64_t dec = bench_run(N, [&]{
+        rle_decoderect(frame, 480, W, H, enc, size);
+        bench_clobber(frame);
+    });
+
+    printf("%-8s %6d bytes %5.1f%% %10llu cycles %8.3f bytes/cycle "
+            "(raw copy %8.3f)\n",
+            name, (int)size, 100.0*size / (W*H),
+            (unsigned long long)dec,
+            (double)(W*H) / (double)(dec|1),
+            (double)(W*H) / (double)(copy|1));
+
+    free(enc);
+    free(frame);
+    free(src);
+}
+
+int main() {
+    compare("bands", bands);
+    compare("noise", noise);
+    return 0;
+}
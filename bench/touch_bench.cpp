@@ -0,0 +1,92 @@
+// How long the render thread stalls on touch input, blocking reads vs
+// the asynchronous snapshot, against the mock I2C bus at 100 kHz
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench.h"
+#include "fsl_i2c.h"
+#include "fsl_ft5406.h"
+#include "fsl_ft5406_mock.h"
+
+#define FRAMES 60
+#define FRAME_US 16000
+
+static ft5406_handle_t handle;
+
+static void touch_at(int x, int y) {
+    touch_point_t t = {kTouch_Contact, 0, (uint16_t)x, (uint16_t)y};
+    FT5406_MockSetTouches(I2C2, 1, &t);
+}
+
+int main() {
+    i2c_master_config_t config;
+    I2C_MasterGetDefaultConfig(&config);
+    config.baudRate_Bps = 100000U;
+    I2C_MasterInit(I2C2, &config, 12000000);
+    FT5406_MockAttach(I2C2);
+
+    status_t status = FT5406_Init(&handle, I2C2);
+    if (status != kStatus_Success) {
+        printf("FT5406_Init failed %d\n", status);
+        return 1;
+    }
+
+    // blocking, what the render loop used to do every frame
+    uint64_t blocking = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        touch_at(i, 2*i);
+        touch_event_t e;
+        int x = -1, y = -1;
+        uint64_t t = bench_ns();
+        FT5406_GetSingleTouch(&handle, &e, &x, &y);
+        blocking += bench_ns() - t;
+        if (x != i || y != 2*i) {
+            printf("blocking read mismatch %d,%d != %d,%d\n", x, y, i, 2*i);
+            return 1;
+        }
+    }
+
+    // async, kicked off by "vsync", render thread only reads snapshots
+    uint64_t async = 0;
+    uint64_t reads = 0;
+    uint32_t lastseq = 0;
+    int fresh = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        touch_at(i, 2*i);
+        FT5406_ReadTouchDataAsync(&handle);
+
+        // render thread hammers the snapshot while the read is in flight
+        uint64_t start = bench_ns();
+        while (bench_ns() - start < FRAME_US*1000ULL) {
+            touch_point_t ts[FT5406_MAX_TOUCHES];
+            int count;
+            uint32_t seq;
+            uint64_t t = bench_ns();
+            status = FT5406_GetLatestMultiTouch(&handle, &count, ts, &seq);
+            async += bench_ns() - t;
+            reads += 1;
+            if (status != kStatus_Success) {
+                continue;
+            }
+
+            // snapshots must never be torn
+            if (count != 1 || ts[0].TOUCH_Y != 2*ts[0].TOUCH_X) {
+                printf("torn snapshot %d: %d,%d\n",
+                        count, ts[0].TOUCH_X, ts[0].TOUCH_Y);
+                return 1;
+            }
+
+            if (seq != lastseq) {
+                fresh += 1;
+                lastseq = seq;
+            }
+        }
+    }
+
+    printf("%-24s %8.1f us/frame\n", "blocking GetSingleTouch",
+            blocking/1000.0/FRAMES);
+    printf("%-24s %8.3f us/read (%d/%d frames fresh)\n",
+            "async snapshot", async/1000.0/(reads|1), fresh, FRAMES);
+    printf("%-24s %8u us on the wire\n", "one 32-byte read",
+            I2C_MockTransferTime(I2C2, &handle.xfer));
+    return 0;
+}
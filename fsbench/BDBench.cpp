@@ -0,0 +1,210 @@
+#include "BDBench.h"
+
+BDBench::BDBench(BlockDevice *bd, void *buffer, bd_size_t io_size,
+        bd_size_t span)
+    : _bd(bd), _buffer((uint8_t*)buffer), _io_size(io_size), _span(span)
+    , _seed(0x2545f491), _running(false)
+    , _thread(osPriorityBelowNormal) {
+    memset(_results, 0, sizeof(_results));
+}
+
+void BDBench::attach(Callback<void(int, uint32_t, uint32_t)> cb) {
+    _cb = cb;
+}
+
+const char *BDBench::name(int test) {
+    static const char *names[BDBENCH_COUNT] = {
+        "erase",
+        "seq prog",
+        "seq read",
+        "rnd read",
+        "rnd prog",
+    };
+    return names[test];
+}
+
+int BDBench::start() {
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    // io has to be a whole number of reads and programs, and the span
+    // a whole number of erase blocks
+    bd_size_t step = _bd->get_program_size();
+    step = (_bd->get_read_size() > step) ? _bd->get_read_size() : step;
+    _io_size = ((_io_size + step-1) / step) * step;
+
+    bd_size_t erase = _bd->get_erase_size();
+    _span = (_span < _bd->size()) ? _span : _bd->size();
+    _span = (_span / erase) * erase;
+    if (_span < erase || _span < _io_size) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _thread.start(callback(this, &BDBench::work));
+}
+
+void BDBench::run() {
+    _running = true;
+    _requests.release();
+}
+
+void BDBench::work() {
+    while (true) {
+        _requests.wait();
+        _running = true;
+
+        int err = round();
+        if (err) {
+            printf("bd bench failed %d\n", err);
+        }
+
+        _running = false;
+    }
+}
+
+int BDBench::round() {
+    printf("bd bench %llu KiB, %llu B io\n",
+            (unsigned long long)_span/1024, (unsigned long long)_io_size);
+
+    for (int i = 0; i < BDBENCH_COUNT; i++) {
+        int err = test(i);
+        if (err) {
+            return err;
+        }
+
+        const Result &r = _results[i];
+        printf("bd %-8s %7lu KiB/s %6lu us %6lu max\n", name(i),
+                (unsigned long)r.kibps(), (unsigned long)r.avg_us(),
+                (unsigned long)r.max_us);
+    }
+
+    return 0;
+}
+
+// xorshift, rand isn't ours to reseed and we're not on the render thread
+uint32_t BDBench::random() {
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+int BDBench::test(int test) {
+    Result r;
+    Result sample;
+    memset(&r, 0, sizeof(r));
+    memset(&sample, 0, sizeof(sample));
+    uint32_t sample_start = Profile::now();
+    int err = 0;
+
+    bd_size_t chunks = _span / _io_size;
+    if (test == BDBENCH_ERASE) {
+        for (bd_addr_t a = 0; a < _span && !err;
+                a += _bd->get_erase_size(a)) {
+            err = op(test, a, r, sample, sample_start);
+        }
+    } else if (test == BDBENCH_SEQ_PROGRAM || test == BDBENCH_SEQ_READ) {
+        for (bd_size_t i = 0; i < chunks && !err; i++) {
+            err = op(test, i*_io_size, r, sample, sample_start);
+        }
+    } else if (test == BDBENCH_RAND_READ) {
+        for (bd_size_t i = 0; i < chunks && !err; i++) {
+            err = op(test, (random() % chunks)*_io_size,
+                    r, sample, sample_start);
+        }
+    } else if (test == BDBENCH_RAND_PROGRAM) {
+        // programs need erased flash, that's not what we're timing here
+        err = _bd->erase(0, _span);
+
+        // visit every chunk once, striding by something coprime to the
+        // chunk count so we don't need a permutation table
+        bd_size_t stride = 40503;
+        while (true) {
+            bd_size_t a = stride, b = chunks;
+            while (b) {
+                bd_size_t t = a % b;
+                a = b;
+                b = t;
+            }
+            if (a == 1) {
+                break;
+            }
+            stride += 2;
+        }
+
+        bd_size_t offset = random();
+        for (bd_size_t i = 0; i < chunks && !err; i++) {
+            err = op(test, ((i*stride + offset) % chunks)*_io_size,
+                    r, sample, sample_start);
+        }
+    }
+
+    if (err) {
+        return err;
+    }
+
+    if (sample.ops && _cb) {
+        _cb(test, sample.kibps(), sample.avg_us());
+    }
+
+    _results[test] = r;
+    return 0;
+}
+
+int BDBench::op(int test, bd_addr_t addr, Result &r, Result &sample,
+        uint32_t &sample_start) {
+    bd_size_t size = _io_size;
+    if (test == BDBENCH_ERASE) {
+        size = _bd->get_erase_size(addr);
+    } else if (test == BDBENCH_SEQ_PROGRAM || test == BDBENCH_RAND_PROGRAM) {
+        // tag chunks with their address so reads can be checked
+        memset(_buffer, (uint8_t)addr, size);
+        memcpy(_buffer, &addr, sizeof(addr));
+    }
+
+    uint32_t t = Profile::now();
+    int err;
+    if (test == BDBENCH_ERASE) {
+        err = _bd->erase(addr, size);
+    } else if (test == BDBENCH_SEQ_PROGRAM || test == BDBENCH_RAND_PROGRAM) {
+        err = _bd->program(_buffer, addr, size);
+    } else {
+        err = _bd->read(_buffer, addr, size);
+    }
+    uint32_t ticks = Profile::now() - t;
+    uint32_t us = Profile::us(ticks);
+
+    if (err) {
+        return err;
+    }
+
+    if (test == BDBENCH_SEQ_READ || test == BDBENCH_RAND_READ) {
+        bd_addr_t tag;
+        memcpy(&tag, _buffer, sizeof(tag));
+        if (tag != addr) {
+            printf("bd bench read 0x%llx back as 0x%llx\n",
+                    (unsigned long long)addr, (unsigned long long)tag);
+            return BD_ERROR_DEVICE_ERROR;
+        }
+    }
+
+    r.bytes += size;
+    r.ops += 1;
+    r.ticks += ticks;
+    r.max_us = (us > r.max_us) ? us : r.max_us;
+
+    sample.bytes += size;
+    sample.ops += 1;
+    sample.ticks += ticks;
+    if (Profile::us(Profile::now() - sample_start) >= SAMPLE_MS*1000) {
+        if (_cb) {
+            _cb(test, sample.kibps(), sample.avg_us());
+        }
+        memset(&sample, 0, sizeof(sample));
+        sample_start = Profile::now();
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#ifndef BD_BENCH_H
+#define BD_BENCH_H
+
+#include "mbed.h"
+#include "BlockDevice.h"
+#include "Profile.h"
+
+// block device tests, in the order a round runs them
+enum {
+    BDBENCH_ERASE,          // erase the whole span, a block at a time
+    BDBENCH_SEQ_PROGRAM,    // program the span front to back
+    BDBENCH_SEQ_READ,       // read it back front to back
+    BDBENCH_RAND_READ,      // read io-sized chunks at random
+    BDBENCH_RAND_PROGRAM,   // erase, then program chunks in random order
+
+    BDBENCH_COUNT,
+};
+
+/**
+ * Block device throughput benchmark
+ *
+ * Runs rounds of sequential and random read/program/erase tests over a
+ * span at the start of a block device on its own low-priority thread.
+ * Each op is timed with the profiler's clock, so this is wall time on
+ * host too. Live samples go to an optional callback every SAMPLE_MS or
+ * so, as throughput in KiB/s and average op latency in microseconds.
+ *
+ * This erases and programs the span, don't point it at anything you
+ * want to keep.
+ */
+class BDBench {
+public:
+    static const int SAMPLE_MS = 100;
+
+    struct Result {
+        uint64_t bytes;
+        uint32_t ops;
+        uint64_t ticks;     // total time spent in ops, in Profile ticks
+        uint32_t max_us;    // slowest op
+
+        // ops can be quicker than a microsecond, so keep ticks around
+        uint32_t kibps() const {
+            return ticks ? (uint32_t)(bytes*1000000*Profile::mhz()
+                    / 1024 / ticks) : 0;
+        }
+
+        uint32_t avg_us() const {
+            return ops ? (uint32_t)(ticks / Profile::mhz() / ops) : 0;
+        }
+    };
+
+    // buffer must hold io_size bytes, io_size and span are rounded to
+    // the device's program and erase sizes
+    BDBench(BlockDevice *bd, void *buffer, bd_size_t io_size,
+            bd_size_t span);
+
+    // called with test, KiB/s and average latency as tests run
+    void attach(Callback<void(int test, uint32_t kibps, uint32_t us)> cb);
+
+    // start the worker, it waits for run
+    int start();
+
+    // queue up a round of every test
+    void run();
+
+    bool running() const { return _running; }
+    static const char *name(int test);
+
+    // results from the last round a test finished in
+    const Result &result(int test) const { return _results[test]; }
+
+private:
+    void work();
+    int round();
+    int test(int test);
+    int op(int test, bd_addr_t addr, Result &r, Result &sample,
+            uint32_t &sample_start);
+    uint32_t random();
+
+    BlockDevice *_bd;
+    uint8_t *_buffer;
+    bd_size_t _io_size;
+    bd_size_t _span;
+    uint32_t _seed;
+
+    Callback<void(int, uint32_t, uint32_t)> _cb;
+    Result _results[BDBENCH_COUNT];
+    volatile bool _running;
+
+    Thread _thread;
+    Semaphore _requests;
+};
+
+#endif
@@ -0,0 +1,276 @@
+#include "CacheBlockDevice.h"
+
+CacheBlockDevice::CacheBlockDevice(BlockDevice *bd, void *buffer,
+        bd_size_t capacity, bd_size_t line_size, int policy)
+    : _bd(bd), _buffer((uint8_t*)buffer), _line_size(line_size)
+    , _lines(capacity / line_size), _policy(policy)
+    , _clock(0), _hand(0) {
+    _meta = new Line[_lines];
+    memset(_meta, 0, _lines*sizeof(Line));
+    reset_stats();
+}
+
+CacheBlockDevice::~CacheBlockDevice() {
+    delete[] _meta;
+}
+
+int CacheBlockDevice::policy(int policy) {
+    int err = invalidate();
+    _policy = policy;
+    return err;
+}
+
+int CacheBlockDevice::invalidate() {
+    int err = flushall();
+    for (int i = 0; i < _lines; i++) {
+        _meta[i].valid = false;
+    }
+
+    return err;
+}
+
+const char *CacheBlockDevice::name(int policy) {
+    static const char *names[CACHE_POLICIES] = {
+        "off",
+        "lru",
+        "clock",
+    };
+    return names[policy];
+}
+
+void CacheBlockDevice::reset_stats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+int CacheBlockDevice::init() {
+    if (_lines < 1 || _line_size % _bd->get_program_size() != 0 ||
+            _line_size % _bd->get_read_size() != 0) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->init();
+}
+
+int CacheBlockDevice::deinit() {
+    int err = flushall();
+    int bd_err = _bd->deinit();
+    return err ? err : bd_err;
+}
+
+int CacheBlockDevice::sync() {
+    int err = flushall();
+    if (err) {
+        return err;
+    }
+
+    return _bd->sync();
+}
+
+void CacheBlockDevice::touch(int i) {
+    _meta[i].used = _clock++;
+    _meta[i].ref = true;
+}
+
+// find a line to reuse, flushing it if it's dirty
+int CacheBlockDevice::evict() {
+    int victim = -1;
+    for (int i = 0; i < _lines && victim < 0; i++) {
+        if (!_meta[i].valid) {
+            victim = i;
+        }
+    }
+
+    if (victim < 0 && _policy == CACHE_LRU) {
+        victim = 0;
+        for (int i = 1; i < _lines; i++) {
+            // stamps wrap, so compare ages
+            if (_clock - _meta[i].used > _clock - _meta[victim].used) {
+                victim = i;
+            }
+        }
+    } else if (victim < 0) {
+        // referenced lines get a second chance
+        while (_meta[_hand].ref) {
+            _meta[_hand].ref = false;
+            _hand = (_hand + 1) % _lines;
+        }
+        victim = _hand;
+        _hand = (_hand + 1) % _lines;
+    }
+
+    int err = flush(victim);
+    if (err) {
+        return err;
+    }
+
+    _meta[victim].valid = false;
+    return victim;
+}
+
+int CacheBlockDevice::lookup(bd_addr_t addr, bool fill) {
+    for (int i = 0; i < _lines; i++) {
+        if (_meta[i].valid && _meta[i].addr == addr) {
+            _stats.hits += 1;
+            touch(i);
+            return i;
+        }
+    }
+
+    _stats.misses += 1;
+    int i = evict();
+    if (i < 0) {
+        return i;
+    }
+
+    if (fill) {
+        int err = _bd->read(&_buffer[i*_line_size], addr, _line_size);
+        _stats.bd_reads += 1;
+        if (err) {
+            return err;
+        }
+    }
+
+    Line &line = _meta[i];
+    line.addr = addr;
+    line.lo = line.hi = 0;
+    line.valid = true;
+    touch(i);
+    return i;
+}
+
+int CacheBlockDevice::flush(int i) {
+    Line &line = _meta[i];
+    if (!line.valid || line.lo == line.hi) {
+        return 0;
+    }
+
+    // round out to whole programs, the cached bytes around the dirty
+    // range are what's on the device already
+    bd_size_t prog = _bd->get_program_size();
+    bd_size_t lo = (line.lo / prog) * prog;
+    bd_size_t hi = ((line.hi + prog-1) / prog) * prog;
+    int err = _bd->program(&_buffer[i*_line_size + lo],
+            line.addr + lo, hi - lo);
+    _stats.bd_programs += 1;
+    if (err) {
+        return err;
+    }
+
+    line.lo = line.hi = 0;
+    return 0;
+}
+
+int CacheBlockDevice::flushall() {
+    for (int i = 0; i < _lines; i++) {
+        int err = flush(i);
+        if (err) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+int CacheBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size) {
+    _stats.reads += 1;
+    if (_policy == CACHE_OFF) {
+        _stats.bd_reads += 1;
+        return _bd->read(buffer, addr, size);
+    }
+
+    uint8_t *data = (uint8_t *)buffer;
+    while (size > 0) {
+        bd_size_t off = addr % _line_size;
+        bd_size_t chunk = _line_size - off;
+        chunk = (chunk < size) ? chunk : size;
+
+        int i = lookup(addr - off, true);
+        if (i < 0) {
+            return i;
+        }
+
+        memcpy(data, &_buffer[i*_line_size + off], chunk);
+        addr += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+
+    return 0;
+}
+
+int CacheBlockDevice::program(const void *buffer,
+        bd_addr_t addr, bd_size_t size) {
+    _stats.programs += 1;
+    if (_policy == CACHE_OFF) {
+        _stats.bd_programs += 1;
+        return _bd->program(buffer, addr, size);
+    }
+
+    const uint8_t *data = (const uint8_t *)buffer;
+    while (size > 0) {
+        bd_size_t off = addr % _line_size;
+        bd_size_t chunk = _line_size - off;
+        chunk = (chunk < size) ? chunk : size;
+
+        // no need to read in a line we're about to cover
+        int i = lookup(addr - off, chunk != _line_size);
+        if (i < 0) {
+            return i;
+        }
+
+        memcpy(&_buffer[i*_line_size + off], data, chunk);
+        Line &line = _meta[i];
+        if (line.lo == line.hi) {
+            line.lo = off;
+            line.hi = off + chunk;
+        } else {
+            line.lo = (off < line.lo) ? off : line.lo;
+            line.hi = (off + chunk > line.hi) ? off + chunk : line.hi;
+        }
+
+        addr += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+
+    return 0;
+}
+
+int CacheBlockDevice::erase(bd_addr_t addr, bd_size_t size) {
+    for (int i = 0; i < _lines; i++) {
+        if (_meta[i].valid && _meta[i].addr >= addr &&
+                _meta[i].addr < addr + size) {
+            _meta[i].valid = false;
+        }
+    }
+
+    return _bd->erase(addr, size);
+}
+
+int CacheBlockDevice::trim(bd_addr_t addr, bd_size_t size) {
+    return _bd->trim(addr, size);
+}
+
+bd_size_t CacheBlockDevice::get_read_size() const {
+    return _bd->get_read_size();
+}
+
+bd_size_t CacheBlockDevice::get_program_size() const {
+    return _bd->get_program_size();
+}
+
+bd_size_t CacheBlockDevice::get_erase_size() const {
+    return _bd->get_erase_size();
+}
+
+bd_size_t CacheBlockDevice::get_erase_size(bd_addr_t addr) const {
+    return _bd->get_erase_size(addr);
+}
+
+int CacheBlockDevice::get_erase_value() const {
+    return _bd->get_erase_value();
+}
+
+bd_size_t CacheBlockDevice::size() const {
+    return _bd->size();
+}
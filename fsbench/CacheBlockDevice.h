@@ -0,0 +1,104 @@
+#ifndef CACHE_BLOCK_DEVICE_H
+#define CACHE_BLOCK_DEVICE_H
+
+#include "mbed.h"
+#include "BlockDevice.h"
+
+// eviction policies, or none to pass everything straight through
+enum {
+    CACHE_OFF,
+    CACHE_LRU,      // evict the line used longest ago
+    CACHE_CLOCK,    // second chance, cheaper to track than LRU
+
+    CACHE_POLICIES,
+};
+
+/**
+ * Write-back line cache in front of a block device
+ *
+ * Reads and programs go through line_size lines kept in a caller
+ * provided buffer, so the caller picks SRAM or SDRAM. Programs only
+ * dirty their line, which goes out as one program of its dirty range on
+ * eviction or sync, coalescing small writes into whole pages when line
+ * size is the flash's page size. Erases drop any cached lines they
+ * cover, dirty or not, since that data's gone anyways.
+ *
+ * Nothing is written until sync, deinit, or eviction, so sync before
+ * pulling the rug. Lines have to be a multiple of the read and program
+ * sizes and divide the erase size.
+ */
+class CacheBlockDevice : public BlockDevice {
+public:
+    struct Stats {
+        uint32_t hits;          // line lookups that hit
+        uint32_t misses;        // and that missed
+        uint32_t reads;         // reads coming in
+        uint32_t programs;      // programs coming in
+        uint32_t bd_reads;      // reads going out
+        uint32_t bd_programs;   // programs going out
+
+        uint32_t hit_pct() const {
+            return (hits + misses) ? 100*hits / (hits + misses) : 0;
+        }
+    };
+
+    CacheBlockDevice(BlockDevice *bd, void *buffer, bd_size_t capacity,
+            bd_size_t line_size=256, int policy=CACHE_LRU);
+    virtual ~CacheBlockDevice();
+
+    // changing policy flushes and empties the cache
+    int policy(int policy);
+    int policy() const { return _policy; }
+    static const char *name(int policy);
+
+    const Stats &stats() const { return _stats; }
+    void reset_stats();
+
+    // flush and drop every line, for when something else has been at
+    // the device underneath us
+    int invalidate();
+
+    virtual int init();
+    virtual int deinit();
+    virtual int sync();
+
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    virtual bd_size_t get_read_size() const;
+    virtual bd_size_t get_program_size() const;
+    virtual bd_size_t get_erase_size() const;
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+    virtual int get_erase_value() const;
+    virtual bd_size_t size() const;
+
+private:
+    struct Line {
+        bd_addr_t addr;
+        uint32_t used;      // LRU stamp
+        uint32_t lo, hi;    // dirty range, clean if equal
+        bool valid;
+        bool ref;           // CLOCK's second chance
+    };
+
+    int lookup(bd_addr_t addr, bool fill);
+    int evict();
+    int flush(int i);
+    int flushall();
+    void touch(int i);
+
+    BlockDevice *_bd;
+    uint8_t *_buffer;
+    bd_size_t _line_size;
+    int _lines;
+    int _policy;
+
+    Line *_meta;
+    uint32_t _clock;
+    int _hand;
+    Stats _stats;
+};
+
+#endif
@@ -0,0 +1,244 @@
+#include "FSBench.h"
+
+const uint32_t FSBench::file_sizes[FSBench::FILE_SIZES] = {
+    4*1024, 32*1024, 128*1024,
+};
+
+const uint32_t FSBench::io_sizes[FSBench::IO_SIZES] = {
+    64, 512, 4096,
+};
+
+FSBench::FSBench(BlockDevice *bd, void *buffer)
+    : _bd(bd), _buffer((uint8_t*)buffer), _seed(0x2545f491)
+    , _count(0), _cache(0), _running(false)
+    , _thread(osPriorityBelowNormal, 8*1024) {
+    memset(_results, 0, sizeof(_results));
+    memset(_cache_stats, 0, sizeof(_cache_stats));
+}
+
+int FSBench::add(FileSystem *fs) {
+    if (_count >= MAX_FS) {
+        return -ENOMEM;
+    }
+
+    _fs[_count++] = fs;
+    return 0;
+}
+
+const char *FSBench::name(int fs) const {
+    return _fs[fs]->getName();
+}
+
+const char *FSBench::pattern(int pattern) {
+    static const char *names[FSBENCH_PATTERNS] = {
+        "append",
+        "overwrite",
+        "rnd read",
+    };
+    return names[pattern];
+}
+
+void FSBench::attach(Callback<void()> cb) {
+    _cb = cb;
+}
+
+int FSBench::start() {
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    return _thread.start(callback(this, &FSBench::work));
+}
+
+void FSBench::run() {
+    _running = true;
+    _requests.release();
+}
+
+void FSBench::work() {
+    while (true) {
+        _requests.wait();
+        _running = true;
+
+        int err = matrix();
+        if (err) {
+            printf("fs bench failed %d\n", err);
+        }
+
+        _running = false;
+    }
+}
+
+// xorshift, same as BDBench
+uint32_t FSBench::random() {
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+int FSBench::matrix() {
+    memset(_results, 0, sizeof(_results));
+    memset(_cache_stats, 0, sizeof(_cache_stats));
+    printf("fsbench,fs,cache,pattern,file_size,io_size,kibps,avg_us,max_us,"
+            "hit_pct,programs,bd_programs\n");
+
+    for (int i = 0; i < _count; i++) {
+        FileSystem *fs = _fs[i];
+        int err = fs->reformat(_bd);
+        if (err) {
+            return err;
+        }
+
+        for (int f = 0; f < FILE_SIZES; f++) {
+            if (file_sizes[f] > _bd->size()/4) {
+                continue;
+            }
+
+            for (int j = 0; j < IO_SIZES; j++) {
+                err = cell(fs, file_sizes[f], io_sizes[j],
+                        _results[i][f][j], _cache_stats[i][f][j]);
+                if (err) {
+                    fs->unmount();
+                    return err;
+                }
+
+                for (int p = 0; p < FSBENCH_PATTERNS; p++) {
+                    report(i, f, j, p);
+                }
+
+                if (_cb) {
+                    _cb();
+                }
+            }
+        }
+
+        err = fs->unmount();
+        if (err) {
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+int FSBench::cell(FileSystem *fs, uint32_t file_size, uint32_t io_size,
+        Result *results, CacheBlockDevice::Stats *cache_stats) {
+    Result r[FSBENCH_PATTERNS];
+    memset(r, 0, sizeof(r));
+
+    // start from nothing, it's fine if there's nothing to remove
+    fs->remove("bench");
+
+    for (int p = 0; p < FSBENCH_PATTERNS; p++) {
+        if (_cache) {
+            _cache->reset_stats();
+        }
+
+        int err = pass(fs, p, file_size, io_size, r[p]);
+        if (err) {
+            return err;
+        }
+
+        if (_cache) {
+            cache_stats[p] = _cache->stats();
+        }
+    }
+
+    memcpy(results, r, sizeof(r));
+    return 0;
+}
+
+// opens and closes count towards throughput, so syncs are paid for
+int FSBench::pass(FileSystem *fs, int pattern,
+        uint32_t file_size, uint32_t io_size, Result &r) {
+    static const int flags[FSBENCH_PATTERNS] = {
+        O_WRONLY | O_CREAT | O_APPEND,
+        O_WRONLY,
+        O_RDONLY,
+    };
+
+    File file;
+    uint32_t t = Profile::now();
+    int err = file.open(fs, "bench", flags[pattern]);
+    r.ticks += Profile::now() - t;
+
+    uint32_t chunks = file_size / io_size;
+    for (uint32_t i = 0; i < chunks && !err; i++) {
+        if (pattern == FSBENCH_RAND_READ) {
+            err = read(file, (random() % chunks)*io_size, io_size, r);
+        } else {
+            err = write(file, i*io_size, io_size, r);
+        }
+    }
+
+    t = Profile::now();
+    int close_err = file.close();
+    int sync_err = _bd->sync();
+    r.ticks += Profile::now() - t;
+    return err ? err : close_err ? close_err : sync_err;
+}
+
+int FSBench::write(File &file, uint32_t off, uint32_t size, Result &r) {
+    // tag chunks with their offset so reads can be checked
+    memset(_buffer, (uint8_t)(off / size), size);
+    memcpy(_buffer, &off, sizeof(off));
+
+    uint32_t ticks = Profile::now();
+    ssize_t res = file.write(_buffer, size);
+    ticks = Profile::now() - ticks;
+    if (res < 0) {
+        return res;
+    } else if ((uint32_t)res != size) {
+        return -ENOSPC;
+    }
+
+    account(r, size, ticks);
+    return 0;
+}
+
+int FSBench::read(File &file, uint32_t off, uint32_t size, Result &r) {
+    uint32_t ticks = Profile::now();
+    off_t pos = file.seek(off, SEEK_SET);
+    ssize_t res = (pos < 0) ? (ssize_t)pos : file.read(_buffer, size);
+    ticks = Profile::now() - ticks;
+    if (res < 0) {
+        return res;
+    }
+
+    uint32_t tag;
+    memcpy(&tag, _buffer, sizeof(tag));
+    if ((uint32_t)res != size || tag != off) {
+        printf("fs bench read 0x%lx back as 0x%lx\n",
+                (unsigned long)off, (unsigned long)tag);
+        return -EIO;
+    }
+
+    account(r, size, ticks);
+    return 0;
+}
+
+void FSBench::account(Result &r, uint32_t size, uint32_t ticks) {
+    uint32_t us = Profile::us(ticks);
+    r.bytes += size;
+    r.ops += 1;
+    r.ticks += ticks;
+    r.max_us = (us > r.max_us) ? us : r.max_us;
+}
+
+void FSBench::report(int fs, int file_size, int io_size, int pattern) {
+    const Result &r = _results[fs][file_size][io_size][pattern];
+    const CacheBlockDevice::Stats &c =
+            _cache_stats[fs][file_size][io_size][pattern];
+    printf("fsbench,%s,%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+            name(fs),
+            _cache ? CacheBlockDevice::name(_cache->policy()) : "none",
+            this->pattern(pattern),
+            (unsigned long)file_sizes[file_size],
+            (unsigned long)io_sizes[io_size],
+            (unsigned long)r.kibps(), (unsigned long)r.avg_us(),
+            (unsigned long)r.max_us,
+            (unsigned long)c.hit_pct(), (unsigned long)c.programs,
+            (unsigned long)c.bd_programs);
+}
@@ -0,0 +1,114 @@
+#ifndef FS_BENCH_H
+#define FS_BENCH_H
+
+#include "mbed.h"
+#include "BlockDevice.h"
+#include "FileSystem.h"
+#include "File.h"
+#include "BDBench.h"
+#include "CacheBlockDevice.h"
+
+// filesystem access patterns, in the order a cell runs them
+enum {
+    FSBENCH_APPEND,         // create the file and append io-sized writes
+    FSBENCH_OVERWRITE,      // rewrite the whole file in place
+    FSBENCH_RAND_READ,      // read io-sized chunks at random
+
+    FSBENCH_PATTERNS,
+};
+
+/**
+ * Filesystem benchmark matrix
+ *
+ * Reformats each filesystem onto the same block device in turn and runs
+ * every pattern over every file size and io size, on its own low-priority
+ * thread like BDBench. Each pass includes its open and close and a block
+ * device sync, so syncs and write-back caches are paid for.
+ * Rows go out on stdout as CSV as they finish, grep for "fsbench," to
+ * pull them out of the console:
+ *
+ *   fsbench,fs,cache,pattern,file_size,io_size,kibps,avg_us,max_us,
+ *           hit_pct,programs,bd_programs
+ *
+ * The cache columns come from the CacheBlockDevice given to cache, if
+ * that's what we're running on, so policies can be compared.
+ *
+ * Sizes too big for a quarter of the block device are skipped, and the
+ * block device is wiped, don't point it at anything you want to keep.
+ */
+class FSBench {
+public:
+    typedef BDBench::Result Result;
+
+    static const int MAX_FS = 2;
+    static const int FILE_SIZES = 3;
+    static const int IO_SIZES = 3;
+    static const uint32_t file_sizes[FILE_SIZES];
+    static const uint32_t io_sizes[IO_SIZES];
+
+    // buffer must hold the biggest io size
+    FSBench(BlockDevice *bd, void *buffer);
+
+    // filesystems to compare, up to MAX_FS
+    int add(FileSystem *fs);
+    int count() const { return _count; }
+    const char *name(int fs) const;
+    static const char *pattern(int pattern);
+
+    // called whenever a cell finishes
+    void attach(Callback<void()> cb);
+
+    // report hit rates from this cache, it should be our block device
+    void cache(CacheBlockDevice *cache) { _cache = cache; }
+
+    // start the worker, it waits for run
+    int start();
+
+    // queue up a run of the whole matrix
+    void run();
+
+    bool running() const { return _running; }
+
+    // results from the last run a cell finished in, zero if skipped
+    const Result &result(int fs, int file_size, int io_size,
+            int pattern) const {
+        return _results[fs][file_size][io_size][pattern];
+    }
+
+    const CacheBlockDevice::Stats &cache_stats(int fs, int file_size,
+            int io_size, int pattern) const {
+        return _cache_stats[fs][file_size][io_size][pattern];
+    }
+
+private:
+    void work();
+    int matrix();
+    int cell(FileSystem *fs, uint32_t file_size, uint32_t io_size,
+            Result *results, CacheBlockDevice::Stats *cache_stats);
+    int pass(FileSystem *fs, int pattern,
+            uint32_t file_size, uint32_t io_size, Result &r);
+    int write(File &file, uint32_t off, uint32_t size, Result &r);
+    int read(File &file, uint32_t off, uint32_t size, Result &r);
+    void account(Result &r, uint32_t size, uint32_t ticks);
+    void report(int fs, int file_size, int io_size, int pattern);
+    uint32_t random();
+
+    BlockDevice *_bd;
+    uint8_t *_buffer;
+    uint32_t _seed;
+
+    FileSystem *_fs[MAX_FS];
+    int _count;
+
+    Callback<void()> _cb;
+    Result _results[MAX_FS][FILE_SIZES][IO_SIZES][FSBENCH_PATTERNS];
+    CacheBlockDevice *_cache;
+    CacheBlockDevice::Stats
+            _cache_stats[MAX_FS][FILE_SIZES][IO_SIZES][FSBENCH_PATTERNS];
+    volatile bool _running;
+
+    Thread _thread;
+    Semaphore _requests;
+};
+
+#endif
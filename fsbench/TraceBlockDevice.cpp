@@ -0,0 +1,164 @@
+#include "TraceBlockDevice.h"
+
+TraceBlockDevice::TraceBlockDevice(BlockDevice *bd)
+    : _bd(bd), _logged(0), _blocks(0), _block_size(0)
+    , _erases(0), _programs(0) {
+    memset(_stats, 0, sizeof(_stats));
+}
+
+TraceBlockDevice::~TraceBlockDevice() {
+    delete[] _erases;
+    delete[] _programs;
+}
+
+int TraceBlockDevice::init() {
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    // counters live as long as we do, so inits after the first are free
+    if (!_erases) {
+        _block_size = _bd->get_erase_size();
+        _blocks = _bd->size() / _block_size;
+        _erases = new uint16_t[_blocks];
+        _programs = new uint16_t[_blocks];
+        memset(_erases, 0, _blocks*sizeof(uint16_t));
+        memset(_programs, 0, _blocks*sizeof(uint16_t));
+    }
+
+    return 0;
+}
+
+int TraceBlockDevice::deinit() {
+    return _bd->deinit();
+}
+
+int TraceBlockDevice::sync() {
+    return _bd->sync();
+}
+
+int TraceBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size) {
+    uint32_t t = Profile::now();
+    int err = _bd->read(buffer, addr, size);
+    trace(TRACE_READ, addr, size, Profile::now() - t);
+    return err;
+}
+
+int TraceBlockDevice::program(const void *buffer,
+        bd_addr_t addr, bd_size_t size) {
+    uint32_t t = Profile::now();
+    int err = _bd->program(buffer, addr, size);
+    trace(TRACE_PROGRAM, addr, size, Profile::now() - t);
+    count(_programs, addr, size);
+    return err;
+}
+
+int TraceBlockDevice::erase(bd_addr_t addr, bd_size_t size) {
+    uint32_t t = Profile::now();
+    int err = _bd->erase(addr, size);
+    trace(TRACE_ERASE, addr, size, Profile::now() - t);
+    count(_erases, addr, size);
+    return err;
+}
+
+int TraceBlockDevice::trim(bd_addr_t addr, bd_size_t size) {
+    return _bd->trim(addr, size);
+}
+
+bd_size_t TraceBlockDevice::get_read_size() const {
+    return _bd->get_read_size();
+}
+
+bd_size_t TraceBlockDevice::get_program_size() const {
+    return _bd->get_program_size();
+}
+
+bd_size_t TraceBlockDevice::get_erase_size() const {
+    return _bd->get_erase_size();
+}
+
+bd_size_t TraceBlockDevice::get_erase_size(bd_addr_t addr) const {
+    return _bd->get_erase_size(addr);
+}
+
+int TraceBlockDevice::get_erase_value() const {
+    return _bd->get_erase_value();
+}
+
+bd_size_t TraceBlockDevice::size() const {
+    return _bd->size();
+}
+
+void TraceBlockDevice::reset() {
+    memset(_stats, 0, sizeof(_stats));
+    _logged = 0;
+    if (_erases) {
+        memset(_erases, 0, _blocks*sizeof(uint16_t));
+        memset(_programs, 0, _blocks*sizeof(uint16_t));
+    }
+}
+
+const char *TraceBlockDevice::name(int type) {
+    static const char *names[TRACE_OPS] = {
+        "read",
+        "program",
+        "erase",
+    };
+    return names[type];
+}
+
+uint32_t TraceBlockDevice::percentile(int type, int p) const {
+    const Stats &s = _stats[type];
+    uint32_t target = ((uint64_t)s.ops*p + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += s.buckets[i];
+        if (seen >= target && seen > 0) {
+            // nothing took longer than the max, and the last bucket
+            // has no real upper bound anyways
+            uint32_t bound = (uint32_t)1 << i;
+            return (bound < s.max_us) ? bound : s.max_us;
+        }
+    }
+
+    return 0;
+}
+
+void TraceBlockDevice::trace(int type, bd_addr_t addr, bd_size_t size,
+        uint32_t ticks) {
+    uint32_t us = Profile::us(ticks);
+
+    // bucket is the bit length, so bucket i holds [2^(i-1), 2^i)
+    int bucket = 0;
+    while (bucket < BUCKETS-1 && (us >> bucket)) {
+        bucket += 1;
+    }
+
+    Stats &s = _stats[type];
+    s.ops += 1;
+    s.bytes += size;
+    s.max_us = (us > s.max_us) ? us : s.max_us;
+    s.buckets[bucket] += 1;
+
+    Op &op = _log[_logged % LOG];
+    op.type = type;
+    op.addr = addr;
+    op.size = size;
+    op.us = us;
+    _logged += 1;
+}
+
+// saturating, a block worn past 65535 is worth noticing anyways
+void TraceBlockDevice::count(uint16_t *counters,
+        bd_addr_t addr, bd_size_t size) {
+    if (!counters || size == 0) {
+        return;
+    }
+
+    bd_size_t first = addr / _block_size;
+    bd_size_t last = (addr + size - 1) / _block_size;
+    for (bd_size_t b = first; b <= last && b < _blocks; b++) {
+        counters[b] += (counters[b] < 0xffff);
+    }
+}
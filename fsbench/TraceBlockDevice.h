@@ -0,0 +1,101 @@
+#ifndef TRACE_BLOCK_DEVICE_H
+#define TRACE_BLOCK_DEVICE_H
+
+#include "mbed.h"
+#include "BlockDevice.h"
+#include "Profile.h"
+
+// traced ops
+enum {
+    TRACE_READ,
+    TRACE_PROGRAM,
+    TRACE_ERASE,
+
+    TRACE_OPS,
+};
+
+/**
+ * Block device decorator that watches everything going through it
+ *
+ * Every read, program and erase is timed and passed straight down. The
+ * last LOG ops are kept with their address, size and duration, each op
+ * type gets a log2-bucketed latency histogram, and each erase block
+ * counts its erases and programs, which is enough to see a filesystem's
+ * write amplification and wear while it runs.
+ *
+ * Counters are only written by whoever does the io, readers on other
+ * threads may see them mid-update, which is fine for drawing.
+ */
+class TraceBlockDevice : public BlockDevice {
+public:
+    static const int LOG = 64;
+    static const int BUCKETS = 24;      // 1us to 8s
+
+    struct Op {
+        uint8_t type;
+        bd_addr_t addr;
+        bd_size_t size;
+        uint32_t us;
+    };
+
+    struct Stats {
+        uint32_t ops;
+        uint64_t bytes;
+        uint32_t max_us;
+        uint32_t buckets[BUCKETS];  // bucket i is under 2^i us
+    };
+
+    TraceBlockDevice(BlockDevice *bd);
+    virtual ~TraceBlockDevice();
+
+    virtual int init();
+    virtual int deinit();
+    virtual int sync();
+
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    virtual bd_size_t get_read_size() const;
+    virtual bd_size_t get_program_size() const;
+    virtual bd_size_t get_erase_size() const;
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+    virtual int get_erase_value() const;
+    virtual bd_size_t size() const;
+
+    // forget everything so far
+    void reset();
+
+    const Stats &stats(int type) const { return _stats[type]; }
+    static const char *name(int type);
+
+    // upper bound of the bucket the p-th percentile falls in, never
+    // more than the max
+    uint32_t percentile(int type, int p) const;
+
+    // ops logged so far, and the i-th most recent
+    uint32_t logged() const { return _logged; }
+    const Op &op(int i) const { return _log[(_logged-1 - i) % LOG]; }
+
+    // per erase block counters, valid after init
+    bd_size_t blocks() const { return _blocks; }
+    uint16_t erases(bd_size_t block) const { return _erases[block]; }
+    uint16_t programs(bd_size_t block) const { return _programs[block]; }
+
+private:
+    void trace(int type, bd_addr_t addr, bd_size_t size, uint32_t ticks);
+    void count(uint16_t *counters, bd_addr_t addr, bd_size_t size);
+
+    BlockDevice *_bd;
+    Stats _stats[TRACE_OPS];
+    Op _log[LOG];
+    volatile uint32_t _logged;
+
+    bd_size_t _blocks;
+    bd_size_t _block_size;
+    uint16_t *_erases;
+    uint16_t *_programs;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef HOST_CALLBACK_H
+#define HOST_CALLBACK_H
+
+/**
+ * Host stand-in for mbed's Callback
+ *
+ * Same construction as mbed's, from a function or an object and method,
+ * but backed by std::function so we don't have to reimplement mbed's
+ * storage tricks.
+ */
+#include <functional>
+#include <assert.h>
+
+namespace mbed {
+
+template <typename F>
+class Callback;
+
+template <typename R, typename... A>
+class Callback<R(A...)> {
+public:
+    Callback(R (*func)(A...) = 0) {
+        if (func) {
+            _func = func;
+        }
+    }
+
+    template <typename T, typename U>
+    Callback(U *obj, R (T::*method)(A...)) {
+        _func = [=](A... a) { return (obj->*method)(a...); };
+    }
+
+    template <typename T, typename U>
+    Callback(const U *obj, R (T::*method)(A...) const) {
+        _func = [=](A... a) { return (obj->*method)(a...); };
+    }
+
+    R call(A... a) const {
+        assert(_func);
+        return _func(a...);
+    }
+
+    R operator()(A... a) const {
+        return call(a...);
+    }
+
+    operator bool() const {
+        return (bool)_func;
+    }
+
+private:
+    std::function<R(A...)> _func;
+};
+
+template <typename R, typename... A>
+Callback<R(A...)> callback(R (*func)(A...)) {
+    return Callback<R(A...)>(func);
+}
+
+template <typename T, typename U, typename R, typename... A>
+Callback<R(A...)> callback(U *obj, R (T::*method)(A...)) {
+    return Callback<R(A...)>(obj, method);
+}
+
+template <typename T, typename U, typename R, typename... A>
+Callback<R(A...)> callback(const U *obj, R (T::*method)(A...) const) {
+    return Callback<R(A...)>(obj, method);
+}
+
+}
+
+using namespace mbed;
+
+#endif
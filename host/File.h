@@ -0,0 +1,62 @@
+#ifndef HOST_FILE_H
+#define HOST_FILE_H
+
+/**
+ * Host stand-in for mbed's File, a handle on a file in a FileSystem
+ */
+#include "FileSystem.h"
+#include <errno.h>
+
+class File {
+public:
+    File() : _fs(0), _file(0) {}
+    ~File() { close(); }
+
+    int open(FileSystem *fs, const char *path, int flags=O_RDONLY) {
+        if (_fs) {
+            return -EINVAL;
+        }
+
+        int err = fs->file_open(&_file, path, flags);
+        if (!err) {
+            _fs = fs;
+        }
+        return err;
+    }
+
+    int close() {
+        if (!_fs) {
+            return 0;
+        }
+
+        int err = _fs->file_close(_file);
+        _fs = 0;
+        return err;
+    }
+
+    ssize_t read(void *buffer, size_t size) {
+        return _fs->file_read(_file, buffer, size);
+    }
+
+    ssize_t write(const void *buffer, size_t size) {
+        return _fs->file_write(_file, buffer, size);
+    }
+
+    int sync() {
+        return _fs->file_sync(_file);
+    }
+
+    off_t seek(off_t offset, int whence=SEEK_SET) {
+        return _fs->file_seek(_file, offset, whence);
+    }
+
+    off_t size() {
+        return _fs->file_size(_file);
+    }
+
+private:
+    FileSystem *_fs;
+    fs_file_t _file;
+};
+
+#endif
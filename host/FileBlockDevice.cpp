@@ -0,0 +1,118 @@
+#include "FileBlockDevice.h"
+#include <string.h>
+
+FileBlockDevice::FileBlockDevice(const char *path, const char *flags,
+        bd_size_t bd_size, bd_size_t r_size, bd_size_t w_size,
+        bd_size_t e_size)
+    : _path(path), _flags(flags)
+    , _read_size(r_size), _program_size(w_size), _erase_size(e_size)
+    , _size(bd_size), _file(0), _init_ref_count(0) {
+}
+
+FileBlockDevice::~FileBlockDevice() {
+    if (_file) {
+        fclose(_file);
+    }
+}
+
+int FileBlockDevice::init() {
+    _init_ref_count += 1;
+    if (_file) {
+        return BD_ERROR_OK;
+    }
+
+    _file = fopen(_path, _flags);
+    if (!_file) {
+        _init_ref_count -= 1;
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    // anything after this is a reopen, keep what we wrote
+    _flags = "r+b";
+
+    // grow to size with erased blocks
+    fseeko(_file, 0, SEEK_END);
+    off_t end = ftello(_file);
+    uint8_t erased[512];
+    memset(erased, 0xff, sizeof(erased));
+    while (end < (off_t)_size) {
+        size_t n = ((off_t)_size - end < (off_t)sizeof(erased))
+                ? (size_t)((off_t)_size - end) : sizeof(erased);
+        if (fwrite(erased, 1, n, _file) != n) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        end += n;
+    }
+
+    return sync();
+}
+
+int FileBlockDevice::deinit() {
+    if (_init_ref_count > 0) {
+        _init_ref_count -= 1;
+    }
+
+    if (_file && _init_ref_count == 0) {
+        fclose(_file);
+        _file = 0;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int FileBlockDevice::sync() {
+    if (!_file || fflush(_file)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int FileBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size) {
+    if (!_file || !is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (fseeko(_file, addr, SEEK_SET) ||
+            fread(buffer, 1, size, _file) != size) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int FileBlockDevice::program(const void *buffer,
+        bd_addr_t addr, bd_size_t size) {
+    if (!_file || !is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (fseeko(_file, addr, SEEK_SET) ||
+            fwrite(buffer, 1, size, _file) != size) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int FileBlockDevice::erase(bd_addr_t addr, bd_size_t size) {
+    if (!_file || !is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    uint8_t erased[512];
+    memset(erased, 0xff, sizeof(erased));
+    if (fseeko(_file, addr, SEEK_SET)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    while (size > 0) {
+        size_t n = (size < sizeof(erased)) ? (size_t)size : sizeof(erased);
+        if (fwrite(erased, 1, n, _file) != n) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        size -= n;
+    }
+
+    return BD_ERROR_OK;
+}
@@ -0,0 +1,51 @@
+#ifndef HOST_FILE_BLOCK_DEVICE_H
+#define HOST_FILE_BLOCK_DEVICE_H
+
+/**
+ * Block device backed by a file on the host
+ *
+ * Same constructor as the FileBlockDevice in mbed-os's unit tests. The
+ * file is grown to size on init with erased 0xff blocks, open it with
+ * "w+b" for a clean device every run or "r+b" to pick up where the last
+ * run left off. Like HeapBlockDevice this has no timing of its own, but
+ * the image can be kept around and compared between runs.
+ *
+ * Inits are counted like mbed's block devices, so a filesystem
+ * unmounting doesn't pull the file out from under anyone else, and
+ * reopening never truncates what's already there.
+ */
+#include "BlockDevice.h"
+#include <stdio.h>
+
+class FileBlockDevice : public BlockDevice {
+public:
+    FileBlockDevice(const char *path, const char *flags, bd_size_t bd_size,
+            bd_size_t r_size=1, bd_size_t w_size=1, bd_size_t e_size=1);
+    virtual ~FileBlockDevice();
+
+    virtual int init();
+    virtual int deinit();
+    virtual int sync();
+
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    virtual bd_size_t get_read_size() const { return _read_size; }
+    virtual bd_size_t get_program_size() const { return _program_size; }
+    virtual bd_size_t get_erase_size() const { return _erase_size; }
+    virtual int get_erase_value() const { return 0xff; }
+    virtual bd_size_t size() const { return _size; }
+
+private:
+    const char *_path;
+    const char *_flags;
+    bd_size_t _read_size;
+    bd_size_t _program_size;
+    bd_size_t _erase_size;
+    bd_size_t _size;
+    FILE *_file;
+    int _init_ref_count;
+};
+
+#endif
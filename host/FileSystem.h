@@ -0,0 +1,48 @@
+#ifndef HOST_FILE_SYSTEM_H
+#define HOST_FILE_SYSTEM_H
+
+/**
+ * Host stand-in for mbed's FileSystem interface
+ *
+ * Only what's reachable through File, no directories or retargeting, so
+ * paths are relative to the filesystem rather than under /name/. Errors
+ * are negative errno codes like on target.
+ */
+#include "BlockDevice.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+typedef void *fs_file_t;
+
+class File;
+
+class FileSystem {
+public:
+    FileSystem(const char *name=NULL) : _name(name) {}
+    virtual ~FileSystem() {}
+
+    const char *getName() const { return _name; }
+
+    virtual int mount(BlockDevice *bd) = 0;
+    virtual int unmount() = 0;
+    virtual int reformat(BlockDevice *bd=NULL) = 0;
+    virtual int remove(const char *path) = 0;
+
+protected:
+    friend class File;
+
+    virtual int file_open(fs_file_t *file, const char *path, int flags) = 0;
+    virtual int file_close(fs_file_t file) = 0;
+    virtual ssize_t file_read(fs_file_t file, void *buffer, size_t size) = 0;
+    virtual ssize_t file_write(fs_file_t file,
+            const void *buffer, size_t size) = 0;
+    virtual int file_sync(fs_file_t file) = 0;
+    virtual off_t file_seek(fs_file_t file, off_t offset, int whence) = 0;
+    virtual off_t file_size(fs_file_t file) = 0;
+
+private:
+    const char *_name;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "HeapBlockDevice.h"
+#include <stdlib.h>
+#include <string.h>
+
+HeapBlockDevice::HeapBlockDevice(bd_size_t size, bd_size_t block)
+    : _read_size(block), _program_size(block), _erase_size(block)
+    , _size(size), _blocks(0) {
+}
+
+HeapBlockDevice::HeapBlockDevice(bd_size_t size,
+        bd_size_t read, bd_size_t program, bd_size_t erase)
+    : _read_size(read), _program_size(program), _erase_size(erase)
+    , _size(size), _blocks(0) {
+}
+
+HeapBlockDevice::~HeapBlockDevice() {
+    free(_blocks);
+}
+
+int HeapBlockDevice::init() {
+    if (!_blocks) {
+        _blocks = (uint8_t*)malloc(_size);
+        if (!_blocks) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+        memset(_blocks, 0xff, _size);
+    }
+
+    return BD_ERROR_OK;
+}
+
+int HeapBlockDevice::deinit() {
+    return BD_ERROR_OK;
+}
+
+int HeapBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size) {
+    if (!_blocks || !is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    memcpy(buffer, &_blocks[addr], size);
+    return BD_ERROR_OK;
+}
+
+int HeapBlockDevice::program(const void *buffer,
+        bd_addr_t addr, bd_size_t size) {
+    if (!_blocks || !is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    memcpy(&_blocks[addr], buffer, size);
+    return BD_ERROR_OK;
+}
+
+int HeapBlockDevice::erase(bd_addr_t addr, bd_size_t size) {
+    if (!_blocks || !is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    memset(&_blocks[addr], 0xff, size);
+    return BD_ERROR_OK;
+}
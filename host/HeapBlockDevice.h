@@ -0,0 +1,41 @@
+#ifndef HOST_HEAP_BLOCK_DEVICE_H
+#define HOST_HEAP_BLOCK_DEVICE_H
+
+/**
+ * Host stand-in for mbed's HeapBlockDevice
+ *
+ * Same constructors as mbed's, backed by one flat chunk of heap. Erased
+ * blocks read back as 0xff like NOR flash. Everything is free, so only
+ * good for checking correctness and overheads above the block device.
+ */
+#include "BlockDevice.h"
+
+class HeapBlockDevice : public BlockDevice {
+public:
+    HeapBlockDevice(bd_size_t size, bd_size_t block=512);
+    HeapBlockDevice(bd_size_t size,
+            bd_size_t read, bd_size_t program, bd_size_t erase);
+    virtual ~HeapBlockDevice();
+
+    virtual int init();
+    virtual int deinit();
+
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    virtual bd_size_t get_read_size() const { return _read_size; }
+    virtual bd_size_t get_program_size() const { return _program_size; }
+    virtual bd_size_t get_erase_size() const { return _erase_size; }
+    virtual int get_erase_value() const { return 0xff; }
+    virtual bd_size_t size() const { return _size; }
+
+private:
+    bd_size_t _read_size;
+    bd_size_t _program_size;
+    bd_size_t _erase_size;
+    bd_size_t _size;
+    uint8_t *_blocks;
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "SPINORBlockDevice.h"
+#include "HeapBlockDevice.h"
+#include "FileBlockDevice.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// command bytes, an opcode and a 24-bit address
+#define SPINOR_CMD_SIZE 4
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+SPINORBlockDevice::SPINORBlockDevice(const char *path, const Config &config)
+    : _config(config), _busy_ns(0) {
+    // storage with the same geometry, we do the page splitting
+    if (path) {
+        _store = new FileBlockDevice(path, "w+b", config.size,
+                1, 1, config.sector_size);
+    } else {
+        _store = new HeapBlockDevice(config.size, 1, 1, config.sector_size);
+    }
+
+    _page = (uint8_t *)malloc(config.page_size);
+}
+
+SPINORBlockDevice::~SPINORBlockDevice() {
+    delete _store;
+    free(_page);
+}
+
+int SPINORBlockDevice::init() {
+    if (!_page) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _store->init();
+}
+
+int SPINORBlockDevice::deinit() {
+    return _store->deinit();
+}
+
+int SPINORBlockDevice::sync() {
+    return _store->sync();
+}
+
+uint64_t SPINORBlockDevice::transfer_ns(bd_size_t bytes) const {
+    return (uint64_t)_config.command_us*1000 +
+            bytes*8*1000000000 / _config.spi_hz;
+}
+
+// sleep until the op would have finished on the real thing
+void SPINORBlockDevice::wait(uint64_t start, uint64_t ns) {
+    _busy_ns += ns;
+
+    uint64_t end = start + ns;
+    struct timespec ts;
+    ts.tv_sec = end / 1000000000;
+    ts.tv_nsec = end % 1000000000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)
+            == EINTR) {
+    }
+}
+
+int SPINORBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size) {
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    uint64_t start = now_ns();
+    int err = _store->read(buffer, addr, size);
+    wait(start, transfer_ns(SPINOR_CMD_SIZE + size));
+    _mutex.unlock();
+    return err;
+}
+
+int SPINORBlockDevice::program(const void *buffer,
+        bd_addr_t addr, bd_size_t size) {
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    uint64_t start = now_ns();
+    int err = program_pages((const uint8_t *)buffer, addr, size, start);
+    _mutex.unlock();
+    return err;
+}
+
+int SPINORBlockDevice::program_pages(const uint8_t *data,
+        bd_addr_t addr, bd_size_t size, uint64_t start) {
+    uint8_t *page = _page;
+    uint64_t ns = 0;
+    while (size > 0) {
+        // programs wrap at page boundaries, so split them like the driver
+        bd_size_t off = addr % _config.page_size;
+        bd_size_t chunk = _config.page_size - off;
+        chunk = (chunk < size) ? chunk : size;
+
+        int err = _store->read(page, addr, chunk);
+        if (err) {
+            return err;
+        }
+
+        // NOR only clears bits
+        for (bd_size_t i = 0; i < chunk; i++) {
+            if (data[i] & ~page[i]) {
+                if (_config.strict) {
+                    fprintf(stderr, "spinor: program over unerased "
+                            "0x%llx\n", (unsigned long long)(addr + i));
+                    return BD_ERROR_DEVICE_ERROR;
+                }
+            }
+            page[i] &= data[i];
+        }
+
+        err = _store->program(page, addr, chunk);
+        if (err) {
+            return err;
+        }
+
+        // write enable, then the page program and the busy wait
+        ns += transfer_ns(1) + transfer_ns(SPINOR_CMD_SIZE + chunk) +
+                (uint64_t)_config.program_us*1000;
+
+        addr += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+
+    wait(start, ns);
+    return BD_ERROR_OK;
+}
+
+int SPINORBlockDevice::erase(bd_addr_t addr, bd_size_t size) {
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.lock();
+    uint64_t start = now_ns();
+    int err = _store->erase(addr, size);
+    bd_size_t sectors = size / _config.sector_size;
+    wait(start, sectors*(transfer_ns(1) + transfer_ns(SPINOR_CMD_SIZE) +
+            (uint64_t)_config.erase_us*1000));
+    _mutex.unlock();
+    return err;
+}
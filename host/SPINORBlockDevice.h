@@ -0,0 +1,78 @@
+#ifndef HOST_SPINOR_BLOCK_DEVICE_H
+#define HOST_SPINOR_BLOCK_DEVICE_H
+
+/**
+ * SPI NOR flash timing model
+ *
+ * Looks like mbed's SPIFBlockDevice from above: byte reads and programs,
+ * sector erases. Underneath, every op takes as long as the flash and the
+ * SPI bus would, programs are split into page programs like the driver
+ * does, and each pays for its command bytes and the part's busy time.
+ * Ops sleep off their modeled time against the monotonic clock, so wall
+ * clock benchmarks see realistic numbers.
+ *
+ * NOR can only clear bits, programming a 1 over a 0 fails in strict mode
+ * (the default) and gets ANDed in like real silicon otherwise.
+ *
+ * Data lives in a file if given one, otherwise on the heap. Like the SPIF
+ * driver, ops hold a lock for their whole duration, so threads sharing
+ * the device queue up behind each other like they would on the bus.
+ */
+#include "mbed.h"
+#include "BlockDevice.h"
+#include <stddef.h>
+
+class SPINORBlockDevice : public BlockDevice {
+public:
+    // defaults are the MX25L12835F on the LPCXpresso54608, with typical
+    // datasheet timings, behind mbed's SPIF driver at its default 40MHz
+    struct Config {
+        bd_size_t size;
+        bd_size_t page_size;
+        bd_size_t sector_size;
+        uint32_t spi_hz;
+        uint32_t command_us;    // driver overhead per transaction
+        uint32_t program_us;    // busy time per page program
+        uint32_t erase_us;      // busy time per sector erase
+        bool strict;
+
+        Config()
+            : size(16*1024*1024), page_size(256), sector_size(4096)
+            , spi_hz(40000000), command_us(5)
+            , program_us(500), erase_us(40000), strict(true) {}
+    };
+
+    SPINORBlockDevice(const char *path=NULL, const Config &config=Config());
+    virtual ~SPINORBlockDevice();
+
+    virtual int init();
+    virtual int deinit();
+    virtual int sync();
+
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    virtual bd_size_t get_read_size() const { return 1; }
+    virtual bd_size_t get_program_size() const { return 1; }
+    virtual bd_size_t get_erase_size() const { return _config.sector_size; }
+    virtual int get_erase_value() const { return 0xff; }
+    virtual bd_size_t size() const { return _config.size; }
+
+    // modeled time spent in ops so far
+    uint64_t busy_us() const { return _busy_ns / 1000; }
+
+private:
+    uint64_t transfer_ns(bd_size_t bytes) const;
+    void wait(uint64_t start, uint64_t ns);
+    int program_pages(const uint8_t *data, bd_addr_t addr, bd_size_t size,
+            uint64_t start);
+
+    Config _config;
+    BlockDevice *_store;
+    uint8_t *_page;
+    uint64_t _busy_ns;
+    Mutex _mutex;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "SlicingBlockDevice.h"
+
+SlicingBlockDevice::SlicingBlockDevice(BlockDevice *bd,
+        bd_addr_t start, bd_addr_t stop)
+    : _bd(bd)
+    , _start_from_end(false), _start(start)
+    , _stop_from_end(false), _stop(stop) {
+    if ((int64_t)_start < 0) {
+        _start_from_end = true;
+        _start = -_start;
+    }
+
+    if ((int64_t)_stop <= 0) {
+        _stop_from_end = true;
+        _stop = -_stop;
+    }
+}
+
+int SlicingBlockDevice::init() {
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    bd_size_t size = _bd->size();
+    if (_start_from_end) {
+        _start_from_end = false;
+        _start = size - _start;
+    }
+
+    if (_stop_from_end) {
+        _stop_from_end = false;
+        _stop = size - _stop;
+    }
+
+    // slices have to be erase aligned and fit
+    if (_start > _stop || _stop > size ||
+            !_bd->is_valid_erase(_start, _stop - _start)) {
+        _bd->deinit();
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return BD_ERROR_OK;
+}
+
+int SlicingBlockDevice::deinit() {
+    return _bd->deinit();
+}
+
+int SlicingBlockDevice::sync() {
+    return _bd->sync();
+}
+
+int SlicingBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size) {
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->read(buffer, addr + _start, size);
+}
+
+int SlicingBlockDevice::program(const void *buffer,
+        bd_addr_t addr, bd_size_t size) {
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->program(buffer, addr + _start, size);
+}
+
+int SlicingBlockDevice::erase(bd_addr_t addr, bd_size_t size) {
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->erase(addr + _start, size);
+}
+
+int SlicingBlockDevice::trim(bd_addr_t addr, bd_size_t size) {
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->trim(addr + _start, size);
+}
+
+bd_size_t SlicingBlockDevice::get_read_size() const {
+    return _bd->get_read_size();
+}
+
+bd_size_t SlicingBlockDevice::get_program_size() const {
+    return _bd->get_program_size();
+}
+
+bd_size_t SlicingBlockDevice::get_erase_size() const {
+    return _bd->get_erase_size();
+}
+
+bd_size_t SlicingBlockDevice::get_erase_size(bd_addr_t addr) const {
+    return _bd->get_erase_size(addr + _start);
+}
+
+int SlicingBlockDevice::get_erase_value() const {
+    return _bd->get_erase_value();
+}
+
+bd_size_t SlicingBlockDevice::size() const {
+    return _stop - _start;
+}
@@ -0,0 +1,41 @@
+#ifndef HOST_SLICING_BLOCK_DEVICE_H
+#define HOST_SLICING_BLOCK_DEVICE_H
+
+/**
+ * Host stand-in for mbed's SlicingBlockDevice
+ *
+ * Same constructor as mbed's, a window onto part of another block
+ * device. Negative start or a zero/negative end count from the end of
+ * the underlying device, which is only known after init.
+ */
+#include "BlockDevice.h"
+
+class SlicingBlockDevice : public BlockDevice {
+public:
+    SlicingBlockDevice(BlockDevice *bd, bd_addr_t start, bd_addr_t end=0);
+
+    virtual int init();
+    virtual int deinit();
+    virtual int sync();
+
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    virtual bd_size_t get_read_size() const;
+    virtual bd_size_t get_program_size() const;
+    virtual bd_size_t get_erase_size() const;
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+    virtual int get_erase_value() const;
+    virtual bd_size_t size() const;
+
+private:
+    BlockDevice *_bd;
+    bool _start_from_end;
+    bd_size_t _start;
+    bool _stop_from_end;
+    bd_size_t _stop;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include "board.h"
+#include "pin_mux.h"
+#include "fsl_sctimer.h"
+#include "host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+GPIO_Type GPIO_mock;
+SCT_Type SCT0_mock;
+
+void BOARD_InitPins(void) {
+    HOST_Init();
+}
+
+void BOARD_BootClockFROHF48M(void) {
+}
+
+status_t BOARD_InitDebugConsole(void) {
+    return kStatus_Success;
+}
+
+// map SDRAM where it is on target, so addresses fit in the LCDC's
+// 32-bit registers
+void BOARD_InitSDRAM(void) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_FIXED_NOREPLACE
+    flags |= MAP_FIXED_NOREPLACE;
+#endif
+    void *sdram = mmap((void*)(uintptr_t)BOARD_SDRAM_ADDR, BOARD_SDRAM_SIZE,
+            PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (sdram != (void*)(uintptr_t)BOARD_SDRAM_ADDR) {
+        fprintf(stderr, "couldn't map SDRAM at 0x%08x\n", BOARD_SDRAM_ADDR);
+        abort();
+    }
+}
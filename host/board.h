@@ -0,0 +1,22 @@
+#ifndef HOST_BOARD_H
+#define HOST_BOARD_H
+
+/**
+ * Host stand-in for the LPCXpresso546xx board header
+ *
+ * The board itself is simulated, see host.h.
+ */
+#include "clock_config.h"
+#include "fsl_common.h"
+#include "fsl_gpio.h"
+
+#define BOARD_DEBUG_UART_CLK_ATTACH kFRO12M_to_FLEXCOMM0
+
+// SDRAM on the EMC's dynamic chip select 0
+#define BOARD_SDRAM_ADDR 0xa0000000U
+#define BOARD_SDRAM_SIZE 0x01000000U
+
+status_t BOARD_InitDebugConsole(void);
+void BOARD_InitSDRAM(void);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef HOST_CLOCK_CONFIG_H
+#define HOST_CLOCK_CONFIG_H
+
+#include "fsl_clock.h"
+
+void BOARD_BootClockFROHF48M(void);
+
+#endif
@@ -0,0 +1,284 @@
+#include "FATFileSystem.h"
+#include "diskio.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// FatFs renamed its config in R0.13
+#if defined(FF_VOLUMES)
+#define FAT_VOLUMES FF_VOLUMES
+#define FAT_MAX_SS FF_MAX_SS
+#else
+#define FAT_VOLUMES _VOLUMES
+#define FAT_MAX_SS _MAX_SS
+#endif
+
+// block devices by FatFs drive number
+static BlockDevice *fat_bds[FAT_VOLUMES];
+static int fat_count;
+
+static bd_size_t fat_ssize(BlockDevice *bd) {
+    bd_size_t ssize = bd->get_erase_size();
+    ssize = (bd->get_program_size() > ssize) ? bd->get_program_size() : ssize;
+    return (ssize > 512) ? ssize : 512;
+}
+
+static int fat_error(FRESULT res) {
+    switch (res) {
+        case FR_OK:                 return 0;
+        case FR_NO_FILE:
+        case FR_NO_PATH:            return -ENOENT;
+        case FR_INVALID_NAME:       return -EINVAL;
+        case FR_DENIED:             return -EACCES;
+        case FR_EXIST:              return -EEXIST;
+        case FR_WRITE_PROTECTED:    return -EROFS;
+        case FR_NOT_ENABLED:
+        case FR_NO_FILESYSTEM:      return -ENODEV;
+        case FR_TOO_MANY_OPEN_FILES: return -ENFILE;
+        case FR_NOT_ENOUGH_CORE:    return -ENOMEM;
+        default:                    return -EIO;
+    }
+}
+
+// disk io for FatFs, sectors map straight onto the block device
+DSTATUS disk_status(BYTE pdrv) {
+    return fat_bds[pdrv] ? 0 : STA_NOINIT;
+}
+
+// attach already inited the block device, FatFs calls this on every
+// mount and mkfs, and nothing would deinit the extra inits
+DSTATUS disk_initialize(BYTE pdrv) {
+    return disk_status(pdrv);
+}
+
+DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count) {
+    BlockDevice *bd = fat_bds[pdrv];
+    bd_size_t ssize = fat_ssize(bd);
+    int err = bd->read(buff, (bd_addr_t)sector*ssize, count*ssize);
+    return err ? RES_PARERR : RES_OK;
+}
+
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count) {
+    BlockDevice *bd = fat_bds[pdrv];
+    bd_size_t ssize = fat_ssize(bd);
+    int err = bd->erase((bd_addr_t)sector*ssize, count*ssize);
+    if (!err) {
+        err = bd->program(buff, (bd_addr_t)sector*ssize, count*ssize);
+    }
+    return err ? RES_PARERR : RES_OK;
+}
+
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff) {
+    BlockDevice *bd = fat_bds[pdrv];
+    if (!bd) {
+        return RES_NOTRDY;
+    }
+
+    switch (cmd) {
+        case CTRL_SYNC:
+            return bd->sync() ? RES_ERROR : RES_OK;
+        case GET_SECTOR_COUNT:
+            *(DWORD *)buff = bd->size() / fat_ssize(bd);
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *(WORD *)buff = fat_ssize(bd);
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *(DWORD *)buff = 1;
+            return RES_OK;
+        default:
+            return RES_PARERR;
+    }
+}
+
+// fixed timestamps keep images comparable between runs
+DWORD get_fattime(void) {
+    return ((DWORD)(2018 - 1980) << 25) | (1 << 21) | (1 << 16);
+}
+
+#if _USE_LFN == 3 || FF_USE_LFN == 3
+void *ff_memalloc(UINT size) {
+    return malloc(size);
+}
+
+void ff_memfree(void *p) {
+    free(p);
+}
+#endif
+
+
+FATFileSystem::FATFileSystem(const char *name)
+    : FileSystem(name), _bd(0), _mounted(false) {
+    _id = (fat_count < FAT_VOLUMES) ? fat_count++ : -1;
+    snprintf(_fsid, sizeof(_fsid), "%d:", _id);
+}
+
+FATFileSystem::~FATFileSystem() {
+    unmount();
+}
+
+// this inits the block device, so every attach needs a deinit
+int FATFileSystem::attach(BlockDevice *bd) {
+    if (!bd || _id < 0 || fat_ssize(bd) > FAT_MAX_SS) {
+        return -EINVAL;
+    }
+
+    int err = bd->init();
+    if (err) {
+        return err;
+    }
+
+    _bd = bd;
+    fat_bds[_id] = bd;
+    return 0;
+}
+
+void FATFileSystem::path(char *buffer, size_t size, const char *path) const {
+    snprintf(buffer, size, "%s%s", _fsid, path);
+}
+
+int FATFileSystem::mount(BlockDevice *bd) {
+    unmount();
+
+    int err = attach(bd);
+    if (err) {
+        return err;
+    }
+
+    err = fat_error(f_mount(&_fs, _fsid, 1));
+    if (err) {
+        bd->deinit();
+        return err;
+    }
+
+    _mounted = true;
+    return 0;
+}
+
+int FATFileSystem::unmount() {
+    if (!_mounted) {
+        return 0;
+    }
+
+    _mounted = false;
+    int err = fat_error(f_mount(NULL, _fsid, 0));
+    int bd_err = _bd->deinit();
+    return err ? err : bd_err;
+}
+
+int FATFileSystem::reformat(BlockDevice *bd) {
+    bd = bd ? bd : _bd;
+    unmount();
+
+    int err = attach(bd);
+    if (err) {
+        return err;
+    }
+
+    // one partition-less volume, auto cluster size
+#if defined(FM_ANY)
+    void *work = malloc(FAT_MAX_SS);
+    if (!work) {
+        bd->deinit();
+        return -ENOMEM;
+    }
+    err = fat_error(f_mkfs(_fsid, FM_ANY | FM_SFD, 0, work, FAT_MAX_SS));
+    free(work);
+#else
+    err = fat_error(f_mkfs(_fsid, 1, 0));
+#endif
+    // mount inits the block device again, so deinit here either way
+    bd->deinit();
+    if (err) {
+        return err;
+    }
+
+    return mount(bd);
+}
+
+int FATFileSystem::remove(const char *path) {
+    char buffer[64];
+    this->path(buffer, sizeof(buffer), path);
+    return fat_error(f_unlink(buffer));
+}
+
+int FATFileSystem::file_open(fs_file_t *file, const char *path, int flags) {
+    char buffer[64];
+    this->path(buffer, sizeof(buffer), path);
+
+    BYTE mode = 0;
+    if ((flags & 3) == O_RDONLY || (flags & 3) == O_RDWR) {
+        mode |= FA_READ;
+    }
+    if ((flags & 3) == O_WRONLY || (flags & 3) == O_RDWR) {
+        mode |= FA_WRITE;
+    }
+
+    if ((flags & O_CREAT) && (flags & O_EXCL)) {
+        mode |= FA_CREATE_NEW;
+    } else if ((flags & O_CREAT) && (flags & O_TRUNC)) {
+        mode |= FA_CREATE_ALWAYS;
+    } else if (flags & O_CREAT) {
+        mode |= FA_OPEN_ALWAYS;
+    }
+
+    FIL *f = new FIL;
+    int err = fat_error(f_open(f, buffer, mode));
+    if (err) {
+        delete f;
+        return err;
+    }
+
+    // FatFs only grew append in R0.12, so do it ourselves
+    if (flags & O_APPEND) {
+        err = fat_error(f_lseek(f, f_size(f)));
+        if (err) {
+            f_close(f);
+            delete f;
+            return err;
+        }
+    }
+
+    *file = f;
+    return 0;
+}
+
+int FATFileSystem::file_close(fs_file_t file) {
+    FIL *f = (FIL *)file;
+    int err = fat_error(f_close(f));
+    delete f;
+    return err;
+}
+
+ssize_t FATFileSystem::file_read(fs_file_t file, void *buffer, size_t size) {
+    UINT n;
+    int err = fat_error(f_read((FIL *)file, buffer, size, &n));
+    return err ? err : (ssize_t)n;
+}
+
+ssize_t FATFileSystem::file_write(fs_file_t file,
+        const void *buffer, size_t size) {
+    UINT n;
+    int err = fat_error(f_write((FIL *)file, buffer, size, &n));
+    return err ? err : (ssize_t)n;
+}
+
+int FATFileSystem::file_sync(fs_file_t file) {
+    return fat_error(f_sync((FIL *)file));
+}
+
+off_t FATFileSystem::file_seek(fs_file_t file, off_t offset, int whence) {
+    FIL *f = (FIL *)file;
+    if (whence == SEEK_END) {
+        offset += f_size(f);
+    } else if (whence == SEEK_CUR) {
+        offset += f_tell(f);
+    }
+
+    int err = fat_error(f_lseek(f, offset));
+    return err ? err : (off_t)f_tell(f);
+}
+
+off_t FATFileSystem::file_size(fs_file_t file) {
+    return f_size((FIL *)file);
+}
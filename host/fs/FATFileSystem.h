@@ -0,0 +1,44 @@
+#ifndef HOST_FAT_FILE_SYSTEM_H
+#define HOST_FAT_FILE_SYSTEM_H
+
+/**
+ * Host build of mbed's FATFileSystem
+ *
+ * Wraps the ChaN FatFs mbed-os ships. Like mbed's, sectors are at least
+ * an erase block so every sector write is an erase and program.
+ */
+#include "FileSystem.h"
+#include "ff.h"
+
+class FATFileSystem : public FileSystem {
+public:
+    FATFileSystem(const char *name=NULL);
+    virtual ~FATFileSystem();
+
+    virtual int mount(BlockDevice *bd);
+    virtual int unmount();
+    virtual int reformat(BlockDevice *bd=NULL);
+    virtual int remove(const char *path);
+
+protected:
+    virtual int file_open(fs_file_t *file, const char *path, int flags);
+    virtual int file_close(fs_file_t file);
+    virtual ssize_t file_read(fs_file_t file, void *buffer, size_t size);
+    virtual ssize_t file_write(fs_file_t file,
+            const void *buffer, size_t size);
+    virtual int file_sync(fs_file_t file);
+    virtual off_t file_seek(fs_file_t file, off_t offset, int whence);
+    virtual off_t file_size(fs_file_t file);
+
+private:
+    int attach(BlockDevice *bd);
+    void path(char *buffer, size_t size, const char *path) const;
+
+    FATFS _fs;
+    BlockDevice *_bd;
+    int _id;
+    char _fsid[4];
+    bool _mounted;
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "LittleFileSystem.h"
+#include <errno.h>
+#include <string.h>
+
+// block device glue
+static int lfs_bd_read(const struct lfs_config *c, lfs_block_t block,
+        lfs_off_t off, void *buffer, lfs_size_t size) {
+    BlockDevice *bd = (BlockDevice *)c->context;
+    return bd->read(buffer, (bd_addr_t)block*c->block_size + off, size);
+}
+
+static int lfs_bd_prog(const struct lfs_config *c, lfs_block_t block,
+        lfs_off_t off, const void *buffer, lfs_size_t size) {
+    BlockDevice *bd = (BlockDevice *)c->context;
+    return bd->program(buffer, (bd_addr_t)block*c->block_size + off, size);
+}
+
+static int lfs_bd_erase(const struct lfs_config *c, lfs_block_t block) {
+    BlockDevice *bd = (BlockDevice *)c->context;
+    return bd->erase((bd_addr_t)block*c->block_size, c->block_size);
+}
+
+static int lfs_bd_sync(const struct lfs_config *c) {
+    BlockDevice *bd = (BlockDevice *)c->context;
+    return bd->sync();
+}
+
+static int lfs_fromflags(int flags) {
+    return (
+        (((flags & 3) == O_RDONLY) ? LFS_O_RDONLY : 0) |
+        (((flags & 3) == O_WRONLY) ? LFS_O_WRONLY : 0) |
+        (((flags & 3) == O_RDWR)   ? LFS_O_RDWR   : 0) |
+        ((flags & O_CREAT)  ? LFS_O_CREAT  : 0) |
+        ((flags & O_EXCL)   ? LFS_O_EXCL   : 0) |
+        ((flags & O_TRUNC)  ? LFS_O_TRUNC  : 0) |
+        ((flags & O_APPEND) ? LFS_O_APPEND : 0));
+}
+
+static int lfs_fromwhence(int whence) {
+    switch (whence) {
+        case SEEK_SET: return LFS_SEEK_SET;
+        case SEEK_CUR: return LFS_SEEK_CUR;
+        case SEEK_END: return LFS_SEEK_END;
+        default: return whence;
+    }
+}
+
+LittleFileSystem::LittleFileSystem(const char *name,
+        lfs_size_t read_size, lfs_size_t prog_size,
+        lfs_size_t block_size, lfs_size_t lookahead)
+    : FileSystem(name), _bd(0), _mounted(false)
+    , _read_size(read_size), _prog_size(prog_size)
+    , _block_size(block_size), _lookahead(lookahead) {
+}
+
+LittleFileSystem::~LittleFileSystem() {
+    unmount();
+}
+
+// same sizing as mbed's, at least as big as the block device needs,
+// this inits the block device, so every configure needs a deinit
+int LittleFileSystem::configure(BlockDevice *bd) {
+    if (!bd) {
+        return -EINVAL;
+    }
+
+    int err = bd->init();
+    if (err) {
+        return err;
+    }
+
+    memset(&_config, 0, sizeof(_config));
+    _config.context = bd;
+    _config.read  = lfs_bd_read;
+    _config.prog  = lfs_bd_prog;
+    _config.erase = lfs_bd_erase;
+    _config.sync  = lfs_bd_sync;
+
+    lfs_size_t read = bd->get_read_size();
+    lfs_size_t prog = bd->get_program_size();
+    lfs_size_t block = bd->get_erase_size();
+    _config.read_size  = (_read_size > read) ? _read_size : read;
+    _config.prog_size  = (_prog_size > prog) ? _prog_size : prog;
+    _config.block_size = (_block_size > block) ? _block_size : block;
+    _config.block_count = bd->size() / _config.block_size;
+
+    lfs_size_t lookahead = 32*((_config.block_count+31)/32);
+    lookahead = (lookahead < _lookahead) ? lookahead : _lookahead;
+#if defined(LFS_VERSION_MAJOR) && LFS_VERSION_MAJOR >= 2
+    _config.cache_size = (_config.read_size > _config.prog_size)
+            ? _config.read_size : _config.prog_size;
+    _config.lookahead_size = lookahead/8;
+    _config.block_cycles = 512;
+#else
+    _config.lookahead = lookahead;
+#endif
+
+    _bd = bd;
+    return 0;
+}
+
+int LittleFileSystem::mount(BlockDevice *bd) {
+    unmount();
+
+    int err = configure(bd);
+    if (err) {
+        return err;
+    }
+
+    err = lfs_mount(&_lfs, &_config);
+    if (err) {
+        bd->deinit();
+        return err;
+    }
+
+    _mounted = true;
+    return 0;
+}
+
+int LittleFileSystem::unmount() {
+    if (!_mounted) {
+        return 0;
+    }
+
+    _mounted = false;
+    int err = lfs_unmount(&_lfs);
+    int bd_err = _bd->deinit();
+    return err ? err : bd_err;
+}
+
+int LittleFileSystem::reformat(BlockDevice *bd) {
+    bd = bd ? bd : _bd;
+    unmount();
+
+    int err = configure(bd);
+    if (err) {
+        return err;
+    }
+
+    // mount inits the block device again, so deinit here either way
+    err = lfs_format(&_lfs, &_config);
+    bd->deinit();
+    if (err) {
+        return err;
+    }
+
+    return mount(bd);
+}
+
+int LittleFileSystem::remove(const char *path) {
+    return lfs_remove(&_lfs, path);
+}
+
+int LittleFileSystem::file_open(fs_file_t *file,
+        const char *path, int flags) {
+    lfs_file_t *f = new lfs_file_t;
+    int err = lfs_file_open(&_lfs, f, path, lfs_fromflags(flags));
+    if (err) {
+        delete f;
+        return err;
+    }
+
+    *file = f;
+    return 0;
+}
+
+int LittleFileSystem::file_close(fs_file_t file) {
+    lfs_file_t *f = (lfs_file_t *)file;
+    int err = lfs_file_close(&_lfs, f);
+    delete f;
+    return err;
+}
+
+ssize_t LittleFileSystem::file_read(fs_file_t file,
+        void *buffer, size_t size) {
+    return lfs_file_read(&_lfs, (lfs_file_t *)file, buffer, size);
+}
+
+ssize_t LittleFileSystem::file_write(fs_file_t file,
+        const void *buffer, size_t size) {
+    return lfs_file_write(&_lfs, (lfs_file_t *)file, buffer, size);
+}
+
+int LittleFileSystem::file_sync(fs_file_t file) {
+    return lfs_file_sync(&_lfs, (lfs_file_t *)file);
+}
+
+off_t LittleFileSystem::file_seek(fs_file_t file, off_t offset, int whence) {
+    return lfs_file_seek(&_lfs, (lfs_file_t *)file,
+            offset, lfs_fromwhence(whence));
+}
+
+off_t LittleFileSystem::file_size(fs_file_t file) {
+    return lfs_file_size(&_lfs, (lfs_file_t *)file);
+}
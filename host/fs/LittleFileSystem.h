@@ -0,0 +1,51 @@
+#ifndef HOST_LITTLE_FILE_SYSTEM_H
+#define HOST_LITTLE_FILE_SYSTEM_H
+
+/**
+ * Host build of mbed's LittleFileSystem
+ *
+ * Wraps the same littlefs core mbed-os ships, with the same defaults, so
+ * host runs see the same block device traffic as target.
+ */
+#include "FileSystem.h"
+extern "C" {
+#include "lfs.h"
+}
+
+class LittleFileSystem : public FileSystem {
+public:
+    LittleFileSystem(const char *name=NULL,
+            lfs_size_t read_size=64, lfs_size_t prog_size=64,
+            lfs_size_t block_size=512, lfs_size_t lookahead=512);
+    virtual ~LittleFileSystem();
+
+    virtual int mount(BlockDevice *bd);
+    virtual int unmount();
+    virtual int reformat(BlockDevice *bd=NULL);
+    virtual int remove(const char *path);
+
+protected:
+    virtual int file_open(fs_file_t *file, const char *path, int flags);
+    virtual int file_close(fs_file_t file);
+    virtual ssize_t file_read(fs_file_t file, void *buffer, size_t size);
+    virtual ssize_t file_write(fs_file_t file,
+            const void *buffer, size_t size);
+    virtual int file_sync(fs_file_t file);
+    virtual off_t file_seek(fs_file_t file, off_t offset, int whence);
+    virtual off_t file_size(fs_file_t file);
+
+private:
+    int configure(BlockDevice *bd);
+
+    lfs_t _lfs;
+    struct lfs_config _config;
+    BlockDevice *_bd;
+    bool _mounted;
+
+    lfs_size_t _read_size;
+    lfs_size_t _prog_size;
+    lfs_size_t _block_size;
+    lfs_size_t _lookahead;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef HOST_FSL_CLOCK_H
+#define HOST_FSL_CLOCK_H
+
+/**
+ * Host stand-in for the clock bits of the NXP SDK's fsl_clock.h
+ *
+ * There are no clocks to gate on a host, these just have to exist.
+ * Frequencies are what the board runs at.
+ */
+#include "fsl_common.h"
+
+typedef enum _clock_ip_name {
+    kCLOCK_InputMux,
+    kCLOCK_Gpio2,
+} clock_ip_name_t;
+
+typedef enum _clock_attach_id {
+    kFRO12M_to_FLEXCOMM0,
+    kFRO12M_to_FLEXCOMM2,
+    kMCLK_to_LCD_CLK,
+    kMCLK_to_SCT_CLK,
+} clock_attach_id_t;
+
+typedef enum _clock_div_name {
+    kCLOCK_DivLcdClk,
+    kCLOCK_DivSctClk,
+} clock_div_name_t;
+
+typedef enum _clock_name {
+    kCLOCK_CoreSysClk,
+    kCLOCK_LCD,
+    kCLOCK_Sct,
+} clock_name_t;
+
+static inline void CLOCK_EnableClock(clock_ip_name_t clk) {}
+static inline void CLOCK_AttachClk(clock_attach_id_t connection) {}
+static inline void CLOCK_SetClkDiv(clock_div_name_t div_name,
+        uint32_t divided_by_value, bool reset) {}
+
+static inline uint32_t CLOCK_GetFreq(clock_name_t clockName) {
+    return 48000000U;
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef HOST_FSL_COMMON_H
+#define HOST_FSL_COMMON_H
+
+/**
+ * Host stand-in for the bits of the NXP SDK's fsl_common.h we use
+ *
+ * Only what the Looky drivers need, status codes match the SDK.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+typedef int32_t status_t;
+
+#define MAKE_STATUS(group, code) ((((group)*100) + (code)))
+
+enum _status_groups {
+    kStatusGroup_Generic = 0,
+    kStatusGroup_FLEXCOMM_I2C = 13,
+};
+
+enum _generic_status {
+    kStatus_Success = MAKE_STATUS(kStatusGroup_Generic, 0),
+    kStatus_Fail = MAKE_STATUS(kStatusGroup_Generic, 1),
+    kStatus_ReadOnly = MAKE_STATUS(kStatusGroup_Generic, 2),
+    kStatus_OutOfRange = MAKE_STATUS(kStatusGroup_Generic, 3),
+    kStatus_InvalidArgument = MAKE_STATUS(kStatusGroup_Generic, 4),
+    kStatus_Timeout = MAKE_STATUS(kStatusGroup_Generic, 5),
+};
+
+#define __DSB() __sync_synchronize()
+
+// CMSIS bits, the simulated board in host.h delivers its own interrupts
+typedef enum IRQn {
+    LCD_IRQn = 45,
+} IRQn_Type;
+
+static inline void NVIC_EnableIRQ(IRQn_Type irq) {}
+static inline void NVIC_DisableIRQ(IRQn_Type irq) {}
+
+#endif
@@ -0,0 +1,33 @@
+#include "fsl_ft5406_mock.h"
+
+// register layout, TD_STATUS then 6 bytes per touch point
+#define FT5406_REG_TD_STATUS 2
+#define FT5406_REG_TOUCH     3
+#define FT5406_TOUCH_SIZE    6
+
+void FT5406_MockAttach(I2C_Type *base) {
+    I2C_MockAttach(base, FT5406_I2C_ADDRESS);
+    FT5406_MockSetTouches(base, 0, NULL);
+}
+
+void FT5406_MockSetTouches(I2C_Type *base,
+        int count, const touch_point_t *touch_array) {
+    uint8_t regs[1 + FT5406_MAX_TOUCHES*FT5406_TOUCH_SIZE];
+    memset(regs, 0, sizeof(regs));
+
+    // idle controllers report "no event" in the first slot
+    regs[1] = (kTouch_Reserved << 6);
+
+    regs[0] = count;
+    for (int i = 0; i < count && i < (int)FT5406_MAX_TOUCHES; i++) {
+        const touch_point_t *t = &touch_array[i];
+        uint8_t *p = &regs[1 + i*FT5406_TOUCH_SIZE];
+        p[0] = (t->TOUCH_EVENT << 6) | ((t->TOUCH_X >> 8) & 0x0f);
+        p[1] = t->TOUCH_X & 0xff;
+        p[2] = (t->TOUCH_ID << 4) | ((t->TOUCH_Y >> 8) & 0x0f);
+        p[3] = t->TOUCH_Y & 0xff;
+    }
+
+    I2C_MockWriteRegs(base, FT5406_I2C_ADDRESS,
+            FT5406_REG_TD_STATUS, regs, sizeof(regs));
+}
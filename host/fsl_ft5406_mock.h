@@ -0,0 +1,20 @@
+#ifndef HOST_FSL_FT5406_MOCK_H
+#define HOST_FSL_FT5406_MOCK_H
+
+/**
+ * Scripted FT5406 on the mock I2C bus
+ *
+ * Encodes touch points into the controller's register layout, so the
+ * real driver in Looky/touchpanel decodes them like it would on target.
+ */
+#include "fsl_i2c.h"
+#include "fsl_ft5406.h"
+
+// attach an FT5406 to the given bus with no touches
+void FT5406_MockAttach(I2C_Type *base);
+
+// set the current touch points, count may be 0
+void FT5406_MockSetTouches(I2C_Type *base,
+        int count, const touch_point_t *touch_array);
+
+#endif
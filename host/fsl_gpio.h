@@ -0,0 +1,40 @@
+#ifndef HOST_FSL_GPIO_H
+#define HOST_FSL_GPIO_H
+
+/**
+ * Host stand-in for the NXP SDK's fsl_gpio.h
+ *
+ * Pins are just bytes, nothing is wired to them.
+ */
+#include "fsl_common.h"
+
+typedef enum _gpio_pin_direction {
+    kGPIO_DigitalInput = 0U,
+    kGPIO_DigitalOutput = 1U,
+} gpio_pin_direction_t;
+
+typedef struct _gpio_pin_config {
+    gpio_pin_direction_t pinDirection;
+    uint8_t outputLogic;
+} gpio_pin_config_t;
+
+typedef struct {
+    volatile uint8_t B[8][32];
+} GPIO_Type;
+
+extern GPIO_Type GPIO_mock;
+#define GPIO (&GPIO_mock)
+
+static inline void GPIO_PinInit(GPIO_Type *base, uint32_t port, uint8_t pin,
+        const gpio_pin_config_t *config) {
+    if (config->pinDirection == kGPIO_DigitalOutput) {
+        base->B[port][pin] = config->outputLogic;
+    }
+}
+
+static inline uint32_t GPIO_ReadPinInput(GPIO_Type *base,
+        uint32_t port, uint32_t pin) {
+    return base->B[port][pin];
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef HOST_FSL_I2C_H
+#define HOST_FSL_I2C_H
+
+/**
+ * Mock I2C master for running the touch driver off-target
+ *
+ * Implements the subset of the SDK's fsl_i2c.h the FT5406 driver uses.
+ * Each bus holds a 256-byte register file per slave address, and
+ * transfers take as long as they would on the wire at the configured
+ * baudrate. Non-blocking transfers complete on a background thread, like
+ * the I2C interrupt would on target, unless the bus is set to instant.
+ */
+#include "fsl_common.h"
+
+enum _i2c_status {
+    kStatus_I2C_Busy = MAKE_STATUS(kStatusGroup_FLEXCOMM_I2C, 0),
+    kStatus_I2C_Idle = MAKE_STATUS(kStatusGroup_FLEXCOMM_I2C, 1),
+    kStatus_I2C_Nak = MAKE_STATUS(kStatusGroup_FLEXCOMM_I2C, 2),
+};
+
+typedef enum _i2c_direction {
+    kI2C_Write = 0U,
+    kI2C_Read = 1U,
+} i2c_direction_t;
+
+enum _i2c_master_transfer_flags {
+    kI2C_TransferDefaultFlag = 0x00U,
+};
+
+typedef struct _i2c_master_config {
+    bool enableMaster;
+    uint32_t baudRate_Bps;
+    bool enableTimeout;
+} i2c_master_config_t;
+
+typedef struct _i2c_master_transfer {
+    uint32_t flags;
+    uint16_t slaveAddress;
+    i2c_direction_t direction;
+    uint32_t subaddress;
+    size_t subaddressSize;
+    void *data;
+    size_t dataSize;
+} i2c_master_transfer_t;
+
+typedef struct I2C_Type I2C_Type;
+typedef struct _i2c_master_handle i2c_master_handle_t;
+
+typedef void (*i2c_master_transfer_callback_t)(I2C_Type *base,
+        i2c_master_handle_t *handle, status_t completionStatus,
+        void *userData);
+
+struct _i2c_master_handle {
+    uint8_t state;
+    i2c_master_transfer_t transfer;
+    i2c_master_transfer_callback_t completionCallback;
+    void *userData;
+};
+
+// mock bus, one per flexcomm we care about
+struct I2C_Type {
+    uint32_t baudRate_Bps;
+    bool present[128];
+    uint8_t regs[128][256];
+    volatile bool busy;
+    bool instant;
+    uint32_t transfers;
+};
+
+extern I2C_Type I2C2_mock;
+#define I2C2 (&I2C2_mock)
+
+void I2C_MasterGetDefaultConfig(i2c_master_config_t *masterConfig);
+void I2C_MasterInit(I2C_Type *base, const i2c_master_config_t *masterConfig,
+        uint32_t srcClock_Hz);
+status_t I2C_MasterTransferBlocking(I2C_Type *base,
+        i2c_master_transfer_t *xfer);
+void I2C_MasterTransferCreateHandle(I2C_Type *base,
+        i2c_master_handle_t *handle,
+        i2c_master_transfer_callback_t callback, void *userData);
+status_t I2C_MasterTransferNonBlocking(I2C_Type *base,
+        i2c_master_handle_t *handle, i2c_master_transfer_t *xfer);
+void I2C_MasterTransferAbort(I2C_Type *base, i2c_master_handle_t *handle);
+
+// mock-only, attach a device and poke at its registers
+void I2C_MockAttach(I2C_Type *base, uint8_t slaveAddress);
+void I2C_MockWriteRegs(I2C_Type *base, uint8_t slaveAddress,
+        uint8_t subaddress, const void *data, size_t size);
+void I2C_MockReadRegs(I2C_Type *base, uint8_t slaveAddress,
+        uint8_t subaddress, void *data, size_t size);
+
+// Make transfers take no time, non-blocking ones complete before they
+// return. Handy for deterministic simulations.
+void I2C_MockSetInstant(I2C_Type *base, bool instant);
+
+// how long a transfer would take on the wire, in microseconds
+uint32_t I2C_MockTransferTime(I2C_Type *base,
+        const i2c_master_transfer_t *xfer);
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef HOST_FSL_LCDC_H
+#define HOST_FSL_LCDC_H
+
+/**
+ * Mock LCD controller for running LookyTouchy off-target
+ *
+ * Implements the subset of the SDK's fsl_lcdc.h LookyTouchy uses. The
+ * panel address is latched and the vertical compare interrupt raised
+ * when the simulated board calls LCDC_MockVsync, which runs
+ * LCD_IRQHandler like the NVIC would. The palette registers hold what
+ * the panel shows, see LCDC_MockScanout.
+ */
+#include "fsl_common.h"
+
+typedef enum _lcdc_polarity_flags {
+    kLCDC_InvertVsyncPolarity = 0x1U,
+    kLCDC_InvertHsyncPolarity = 0x2U,
+} lcdc_polarity_flags_t;
+
+typedef enum _lcdc_bpp {
+    kLCDC_1BPP = 0U,
+    kLCDC_2BPP = 1U,
+    kLCDC_4BPP = 2U,
+    kLCDC_8BPP = 3U,
+    kLCDC_16BPP = 4U,
+    kLCDC_24BPP = 5U,
+    kLCDC_16BPP565 = 6U,
+    kLCDC_12BPP = 7U,
+} lcdc_bpp_t;
+
+typedef enum _lcdc_display {
+    kLCDC_DisplayTFT = 0x20U,
+} lcdc_display_t;
+
+typedef enum _lcdc_data_format {
+    kLCDC_LittleEndian = 0U,
+    kLCDC_WinCeMode = 0x1U,
+} lcdc_data_format_t;
+
+typedef enum _lcdc_panel {
+    kLCDC_UpperPanel,
+    kLCDC_LowerPanel,
+} lcdc_panel_t;
+
+typedef enum _lcdc_vertical_compare_interrupt_mode {
+    kLCDC_StartOfVsync,
+    kLCDC_StartOfBackPorch,
+    kLCDC_StartOfActiveVideo,
+    kLCDC_StartOfFrontPorch,
+} lcdc_vertical_compare_interrupt_mode_t;
+
+enum _lcdc_interrupts {
+    kLCDC_CursorInterrupt = 0x1U,
+    kLCDC_FifoUnderflowInterrupt = 0x2U,
+    kLCDC_BaseAddrUpdateInterrupt = 0x4U,
+    kLCDC_VerticalCompareInterrupt = 0x8U,
+    kLCDC_AhbErrorInterrupt = 0x10U,
+};
+
+typedef struct _lcdc_config {
+    uint32_t panelClock_Hz;
+    uint16_t ppl;
+    uint8_t hsw;
+    uint8_t hfp;
+    uint8_t hbp;
+    uint16_t lpp;
+    uint8_t vsw;
+    uint8_t vfp;
+    uint8_t vbp;
+    uint8_t acBiasFreq;
+    uint16_t polarityFlags;
+    bool enableLineEnd;
+    uint8_t lineEndDelay;
+    uint32_t upperPanelAddr;
+    uint32_t lowerPanelAddr;
+    lcdc_bpp_t bpp;
+    lcdc_data_format_t dataFormat;
+    bool swapRedBlue;
+    lcdc_display_t display;
+} lcdc_config_t;
+
+// mock controller, registers plus what's on screen
+struct LCD_Type {
+    lcdc_config_t config;
+    uint32_t UPBASE;
+    uint32_t PAL[128];
+    uint32_t INTMSK;
+    uint32_t INTRAW;
+    bool powered;
+
+    // latched at vsync, what the panel is showing
+    uint32_t scanout;
+    uint32_t frames;
+};
+
+extern LCD_Type LCD_mock;
+#define LCD (&LCD_mock)
+
+extern "C" void LCD_IRQHandler(void);
+
+void LCDC_GetDefaultConfig(lcdc_config_t *config);
+status_t LCDC_Init(LCD_Type *base, const lcdc_config_t *config,
+        uint32_t srcClock_Hz);
+void LCDC_Start(LCD_Type *base);
+void LCDC_PowerUp(LCD_Type *base);
+void LCDC_SetPanelAddr(LCD_Type *base, lcdc_panel_t panel, uint32_t addr);
+void LCDC_SetPalette(LCD_Type *base, const uint32_t *palette,
+        uint8_t count_words);
+void LCDC_SetVerticalInterruptMode(LCD_Type *base,
+        lcdc_vertical_compare_interrupt_mode_t mode);
+void LCDC_EnableInterrupts(LCD_Type *base, uint32_t mask);
+uint32_t LCDC_GetEnabledInterruptsPendingStatus(LCD_Type *base);
+void LCDC_ClearInterruptsStatus(LCD_Type *base, uint32_t mask);
+
+// mock-only, latch the panel address and raise the vertical compare
+// interrupt, returns true if the panel is on
+bool LCDC_MockVsync(LCD_Type *base);
+
+// mock-only, convert what's on screen to 8-bit RGB triples
+void LCDC_MockScanout(LCD_Type *base, uint8_t *rgb);
+
+#endif
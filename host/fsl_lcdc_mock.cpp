@@ -0,0 +1,114 @@
+#include "fsl_lcdc.h"
+
+LCD_Type LCD_mock;
+
+void LCDC_GetDefaultConfig(lcdc_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->panelClock_Hz = 0U;
+    config->ppl = 0U;
+    config->bpp = kLCDC_16BPP565;
+    config->dataFormat = kLCDC_LittleEndian;
+    config->display = kLCDC_DisplayTFT;
+}
+
+status_t LCDC_Init(LCD_Type *base, const lcdc_config_t *config,
+        uint32_t srcClock_Hz) {
+    // we only know how to show palettized frames and 5:6:5
+    if (config->bpp > kLCDC_8BPP && config->bpp != kLCDC_16BPP565) {
+        return kStatus_InvalidArgument;
+    }
+
+    memset(base, 0, sizeof(*base));
+    base->config = *config;
+    base->UPBASE = config->upperPanelAddr;
+    base->scanout = config->upperPanelAddr;
+    return kStatus_Success;
+}
+
+void LCDC_Start(LCD_Type *base) {
+}
+
+void LCDC_PowerUp(LCD_Type *base) {
+    base->powered = true;
+}
+
+void LCDC_SetPanelAddr(LCD_Type *base, lcdc_panel_t panel, uint32_t addr) {
+    if (panel == kLCDC_UpperPanel) {
+        base->UPBASE = addr;
+    }
+}
+
+void LCDC_SetPalette(LCD_Type *base, const uint32_t *palette,
+        uint8_t count_words) {
+    if (count_words > 128) {
+        count_words = 128;
+    }
+
+    memcpy(base->PAL, palette, count_words*sizeof(uint32_t));
+}
+
+void LCDC_SetVerticalInterruptMode(LCD_Type *base,
+        lcdc_vertical_compare_interrupt_mode_t mode) {
+}
+
+void LCDC_EnableInterrupts(LCD_Type *base, uint32_t mask) {
+    base->INTMSK |= mask;
+}
+
+uint32_t LCDC_GetEnabledInterruptsPendingStatus(LCD_Type *base) {
+    return base->INTRAW & base->INTMSK;
+}
+
+void LCDC_ClearInterruptsStatus(LCD_Type *base, uint32_t mask) {
+    base->INTRAW &= ~mask;
+}
+
+bool LCDC_MockVsync(LCD_Type *base) {
+    if (!base->powered) {
+        return false;
+    }
+
+    base->scanout = base->UPBASE;
+    base->frames += 1;
+
+    base->INTRAW |= kLCDC_VerticalCompareInterrupt | kLCDC_BaseAddrUpdateInterrupt;
+    if (base->INTRAW & base->INTMSK) {
+        LCD_IRQHandler();
+    }
+
+    return true;
+}
+
+void LCDC_MockScanout(LCD_Type *base, uint8_t *rgb) {
+    const uint8_t *pixels = (const uint8_t*)(uintptr_t)base->scanout;
+    const uint16_t *palette = (const uint16_t*)base->PAL;
+
+    if (base->config.bpp == kLCDC_16BPP565) {
+        const uint16_t *p16 = (const uint16_t*)pixels;
+        for (int i = 0; i < base->config.ppl*base->config.lpp; i++) {
+            uint8_t r = (p16[i] >> 11) & 0x1f;
+            uint8_t g = (p16[i] >>  5) & 0x3f;
+            uint8_t b = (p16[i] >>  0) & 0x1f;
+            rgb[3*i+0] = (r << 3) | (r >> 2);
+            rgb[3*i+1] = (g << 2) | (g >> 4);
+            rgb[3*i+2] = (b << 3) | (b >> 2);
+        }
+        return;
+    }
+
+    // WinCE mode, sub-byte pixels are msb first
+    int bpp = 1 << base->config.bpp;
+    for (int i = 0; i < base->config.ppl*base->config.lpp; i++) {
+        int shift = 8 - bpp*(i % (8/bpp) + 1);
+        int index = (pixels[i*bpp/8] >> shift) & ((1 << bpp) - 1);
+
+        // palette entries are 1:5:5:5, red on top
+        uint16_t c = palette[index];
+        uint8_t r = (c >> 10) & 0x1f;
+        uint8_t g = (c >>  5) & 0x1f;
+        uint8_t b = (c >>  0) & 0x1f;
+        rgb[3*i+0] = (r << 3) | (r >> 2);
+        rgb[3*i+1] = (g << 3) | (g >> 2);
+        rgb[3*i+2] = (b << 3) | (b >> 2);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef HOST_FSL_SCTIMER_H
+#define HOST_FSL_SCTIMER_H
+
+/**
+ * Host stand-in for the NXP SDK's fsl_sctimer.h
+ *
+ * Only drives the backlight on target, so there's nothing to simulate.
+ */
+#include "fsl_common.h"
+
+typedef struct {
+    uint32_t dummy;
+} SCT_Type;
+
+extern SCT_Type SCT0_mock;
+#define SCT0 (&SCT0_mock)
+
+typedef enum _sctimer_out {
+    kSCTIMER_Out_5 = 5,
+} sctimer_out_t;
+
+typedef enum _sctimer_pwm_level_select {
+    kSCTIMER_LowTrue = 0,
+    kSCTIMER_HighTrue,
+} sctimer_pwm_level_select_t;
+
+typedef enum _sctimer_pwm_mode {
+    kSCTIMER_EdgeAlignedPwm = 0,
+    kSCTIMER_CenterAlignedPwm,
+} sctimer_pwm_mode_t;
+
+typedef struct _sctimer_config {
+    bool enableCounterUnify;
+} sctimer_config_t;
+
+typedef struct _sctimer_pwm_signal_param {
+    sctimer_out_t output;
+    sctimer_pwm_level_select_t level;
+    uint8_t dutyCyclePercent;
+} sctimer_pwm_signal_param_t;
+
+static inline void SCTIMER_GetDefaultConfig(sctimer_config_t *config) {
+    config->enableCounterUnify = true;
+}
+
+static inline status_t SCTIMER_Init(SCT_Type *base,
+        const sctimer_config_t *config) {
+    return kStatus_Success;
+}
+
+static inline status_t SCTIMER_SetupPwm(SCT_Type *base,
+        const sctimer_pwm_signal_param_t *pwmParams,
+        sctimer_pwm_mode_t mode, uint32_t pwmFreq_Hz, uint32_t srcClock_Hz,
+        uint32_t *event) {
+    *event = 0;
+    return kStatus_Success;
+}
+
+#endif
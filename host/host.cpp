@@ -0,0 +1,275 @@
+#include "host.h"
+#include "mbed.h"
+#include "fsl_lcdc.h"
+#include "fsl_i2c.h"
+#include "fsl_ft5406_mock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+// configuration, see host.h
+static int frame_limit;
+static bool fast;
+static const char *dump_path;
+
+// simulated time, guarded by clock_lock so wait_ms can sleep on it
+static std::mutex clock_lock;
+static std::condition_variable clock_tick;
+static uint64_t now_us;
+static uint64_t next_vsync_us;
+static uint64_t wall_start_ns;
+
+struct TouchStep {
+    int frame;
+    int id;
+    int x;
+    int y;      // -1 to lift
+};
+
+// created on first use, we're brought up from LookyTouchy's constructor
+// which may run before our static initializers
+static std::vector<TouchStep> &touch_script() {
+    static std::vector<TouchStep> script;
+    return script;
+}
+
+static unsigned touch_next;
+static touch_point_t touches[FT5406_MAX_TOUCHES];
+static bool touch_down[FT5406_MAX_TOUCHES];
+
+static uint64_t wall_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+// stdout goes to the overridden console, like mbed's retargeting
+__attribute__((weak))
+mbed::FileHandle *mbed::mbed_override_console(int fd) {
+    return NULL;
+}
+
+static FILE *console_copy;
+
+static ssize_t console_write(void *cookie, const char *buf, size_t size) {
+    if (console_copy) {
+        fwrite(buf, 1, size, console_copy);
+        fflush(console_copy);
+    }
+
+    mbed::FileHandle *console = mbed::mbed_override_console(STDOUT_FILENO);
+    if (console) {
+        return console->write(buf, size);
+    }
+
+    return write(STDOUT_FILENO, buf, size);
+}
+
+static void load_touch_script(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "couldn't open touch script %s\n", path);
+        exit(1);
+    }
+
+    char line[256];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno += 1;
+        char *comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+
+        TouchStep s;
+        char lift;
+        int n = sscanf(line, "%d %d %d %d", &s.frame, &s.id, &s.x, &s.y);
+        if (n == 4) {
+            // down or move
+        } else if (n == 2 &&
+                sscanf(line, "%*d %*d %c", &lift) == 1 && lift == '-') {
+            s.x = -1;
+            s.y = -1;
+        } else if (n <= 0) {
+            continue;
+        } else {
+            fprintf(stderr, "%s:%d: bad touch step\n", path, lineno);
+            exit(1);
+        }
+
+        if (s.id < 0 || s.id >= (int)FT5406_MAX_TOUCHES) {
+            fprintf(stderr, "%s:%d: touch id out of range\n", path, lineno);
+            exit(1);
+        }
+
+        touch_script().push_back(s);
+    }
+
+    fclose(f);
+}
+
+// play any steps for this frame into the touch panel's registers
+static void play_touch_script(int frame) {
+    bool changed = false;
+    const std::vector<TouchStep> &script = touch_script();
+    for (; touch_next < script.size() &&
+            script[touch_next].frame <= frame; touch_next++) {
+        const TouchStep &s = script[touch_next];
+        touch_point_t &t = touches[s.id];
+        if (s.x < 0) {
+            touch_down[s.id] = false;
+        } else {
+            t.TOUCH_EVENT = touch_down[s.id] ? kTouch_Contact : kTouch_Down;
+            t.TOUCH_ID = s.id;
+            // the panel is mounted sideways, LookyTouchy flips these back
+            t.TOUCH_X = s.y;
+            t.TOUCH_Y = s.x;
+            touch_down[s.id] = true;
+        }
+        changed = true;
+    }
+
+    if (changed) {
+        touch_point_t points[FT5406_MAX_TOUCHES];
+        int count = 0;
+        for (int i = 0; i < (int)FT5406_MAX_TOUCHES; i++) {
+            if (touch_down[i]) {
+                points[count++] = touches[i];
+            }
+        }
+        FT5406_MockSetTouches(I2C2, count, points);
+    }
+}
+
+static void dump(int frame) {
+    char path[1024];
+    snprintf(path, sizeof(path), dump_path, frame);
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "couldn't open %s\n", path);
+        exit(1);
+    }
+
+    int w = LCD->config.ppl;
+    int h = LCD->config.lpp;
+    const char *ext = strrchr(dump_path, '.');
+    if (ext && strcmp(ext, ".ppm") == 0) {
+        std::vector<uint8_t> rgb(3*w*h);
+        LCDC_MockScanout(LCD, &rgb[0]);
+        fprintf(f, "P6\n%d %d\n255\n", w, h);
+        fwrite(&rgb[0], 1, rgb.size(), f);
+    } else {
+        int bpp = (LCD->config.bpp == kLCDC_16BPP565)
+                ? 16 : 1 << LCD->config.bpp;
+        fwrite((const void*)(uintptr_t)LCD->scanout, 1, w*h*bpp/8, f);
+    }
+
+    fclose(f);
+}
+
+void HOST_Init(void) {
+    const char *frames = getenv("LOOKY_FRAMES");
+    frame_limit = frames ? atoi(frames) : 0;
+    const char *fast_ = getenv("LOOKY_FAST");
+    fast = fast_ && atoi(fast_);
+    dump_path = getenv("LOOKY_DUMP");
+
+    const char *touch = getenv("LOOKY_TOUCH");
+    if (touch) {
+        load_touch_script(touch);
+    }
+
+    const char *copy = getenv("LOOKY_LOG");
+    if (copy) {
+        console_copy = fopen(copy, "w");
+        if (!console_copy) {
+            fprintf(stderr, "couldn't open console log %s\n", copy);
+            exit(1);
+        }
+    }
+
+    // console is unbuffered on target
+    cookie_io_functions_t console = {NULL, console_write, NULL, NULL};
+    stdout = fopencookie(NULL, "w", console);
+    setvbuf(stdout, NULL, _IONBF, 0);
+
+    // touch panel on I2C2, reads finish immediately so scripted touches
+    // land on the frame they're scripted for
+    I2C_MockSetInstant(I2C2, true);
+    FT5406_MockAttach(I2C2);
+
+    now_us = 0;
+    next_vsync_us = HOST_VSYNC_US;
+    wall_start_ns = wall_ns();
+}
+
+uint64_t HOST_GetTime(void) {
+    if (fast) {
+        std::lock_guard<std::mutex> lock(clock_lock);
+        return now_us;
+    }
+
+    return (wall_ns() - wall_start_ns) / 1000;
+}
+
+void HOST_WaitUntil(uint64_t t) {
+    if (fast) {
+        std::unique_lock<std::mutex> lock(clock_lock);
+        while (now_us < t) {
+            clock_tick.wait(lock);
+        }
+    } else {
+        uint64_t now = HOST_GetTime();
+        if (t > now) {
+            usleep(t - now);
+        }
+    }
+}
+
+void HOST_WaitForInterrupt(void) {
+    // we're the only thing moving time forward when fast, otherwise
+    // wait for the next vsync, if we missed some the panel just kept
+    // showing the old frame
+    if (!fast) {
+        uint64_t now = HOST_GetTime();
+        if (next_vsync_us <= now) {
+            next_vsync_us += ((now - next_vsync_us) / HOST_VSYNC_US + 1)
+                    * HOST_VSYNC_US;
+        }
+        HOST_WaitUntil(next_vsync_us);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(clock_lock);
+        now_us = next_vsync_us;
+    }
+    next_vsync_us += HOST_VSYNC_US;
+
+    // touches go in before the IRQ kicks off the touch panel read
+    int frame = LCD->frames;
+    play_touch_script(frame);
+
+    if (!LCDC_MockVsync(LCD)) {
+        clock_tick.notify_all();
+        return;
+    }
+
+    if (dump_path) {
+        dump(frame);
+    }
+
+    clock_tick.notify_all();
+
+    if (frame_limit && (int)LCD->frames >= frame_limit) {
+        double s = (wall_ns() - wall_start_ns) / 1e9;
+        fprintf(stderr, "%d frames in %.3f s, %.1f frames/s\n",
+                LCD->frames, s, LCD->frames / s);
+        _exit(0);
+    }
+}
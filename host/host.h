@@ -0,0 +1,45 @@
+#ifndef HOST_H
+#define HOST_H
+
+/**
+ * Simulated board for running LookyTouchy on a host
+ *
+ * Stands in for the LPC546xx: SDRAM is anonymous memory mapped where
+ * the real SDRAM lives, the LCD scans out on a simulated 60Hz vsync,
+ * and the FT5406 replays a touch script. Since main() is the same as
+ * on target, this is configured with environment variables:
+ *
+ *   LOOKY_FRAMES=n    exit after n frames and report throughput
+ *   LOOKY_FAST=1      don't wait on the wall clock, vsync as soon as
+ *                     the render loop waits for it, simulated time still
+ *                     moves at 60Hz so runs are repeatable
+ *   LOOKY_DUMP=path   write frames as they go on screen, .ppm for RGB,
+ *                     anything else for raw pixels, a %d in path
+ *                     is replaced with the frame number
+ *   LOOKY_TOUCH=path  touch script, lines of "frame id x y" put contact
+ *                     id down at x, y (or move it) starting at that frame,
+ *                     "frame id -" lifts it, # starts a comment
+ *   LOOKY_LOG=path    copy everything printed to the console to path,
+ *                     handy for pulling bench CSVs out of a run
+ *
+ * stdout goes to mbed_override_console like on target, so reports go
+ * to stderr.
+ */
+#include <stdint.h>
+
+#define HOST_VSYNC_US (1000000/60)
+
+// bring up the simulated board
+void HOST_Init(void);
+
+// simulated time in microseconds
+uint64_t HOST_GetTime(void);
+
+// Sleep until the next interrupt, this is where the vsync clock ticks.
+// Only the rendering thread should block here.
+void HOST_WaitForInterrupt(void);
+
+// sleep until simulated time reaches t
+void HOST_WaitUntil(uint64_t t);
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef HOST_MBED_H
+#define HOST_MBED_H
+
+/**
+ * Host stand-in for the bits of mbed-os Looky and main.cpp use
+ *
+ * Threads are real threads, but time comes from the simulated board in
+ * host.h, so Timer and wait_ms follow the simulated vsync clock. Anything
+ * blocking on an EventFlags lets the board fire its interrupts first,
+ * like a WFI would on target.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <sys/types.h>
+#include <mutex>
+#include <condition_variable>
+#include "fsl_common.h"
+#include "Callback.h"
+#include "host.h"
+
+#define MBED_ASSERT assert
+#define MBED_STATIC_ASSERT(expr, msg) static_assert(expr, msg)
+
+typedef enum {
+    osOK = 0,
+    osErrorResource = -3,
+} osStatus;
+
+typedef enum {
+    osPriorityLow = 8,
+    osPriorityBelowNormal = 16,
+    osPriorityNormal = 24,
+    osPriorityAboveNormal = 32,
+    osPriorityHigh = 40,
+} osPriority;
+
+#define osWaitForever 0xffffffffU
+
+namespace mbed {
+
+class FileHandle {
+public:
+    virtual ~FileHandle() {}
+    virtual ssize_t write(const void *buffer, size_t size) = 0;
+    virtual ssize_t read(void *buffer, size_t size) = 0;
+    virtual off_t seek(off_t offset, int whence = SEEK_SET) = 0;
+    virtual off_t size() { return -EINVAL; }
+    virtual int close() = 0;
+};
+
+// stdout goes here if overridden, like on target
+FileHandle *mbed_override_console(int fd);
+
+class Timer {
+public:
+    Timer() : _running(false), _start(0), _time(0) {}
+
+    void start();
+    void stop();
+    void reset();
+    int read_us() { return read_high_resolution_us(); }
+    int read_ms() { return read_high_resolution_us() / 1000; }
+    float read() { return read_high_resolution_us() / 1000000.0f; }
+    uint64_t read_high_resolution_us();
+
+private:
+    bool _running;
+    uint64_t _start;
+    uint64_t _time;
+};
+
+}
+
+namespace rtos {
+
+class Thread {
+public:
+    Thread(osPriority priority = osPriorityNormal,
+            uint32_t stack_size = 0, unsigned char *stack_mem = 0,
+            const char *name = 0) {}
+    osStatus start(mbed::Callback<void()> task);
+};
+
+// unlike EventFlags, these are for threads waiting on other threads
+class Semaphore {
+public:
+    Semaphore(int32_t count = 0) : _count(count) {}
+
+    int32_t wait(uint32_t millisec = osWaitForever);
+    osStatus release();
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    int32_t _count;
+};
+
+class Mutex {
+public:
+    void lock() { _mutex.lock(); }
+    bool trylock() { return _mutex.try_lock(); }
+    void unlock() { _mutex.unlock(); }
+
+private:
+    std::recursive_mutex _mutex;
+};
+
+class EventFlags {
+public:
+    EventFlags() : _flags(0) {}
+
+    uint32_t set(uint32_t flags);
+    uint32_t clear(uint32_t flags = 0x7fffffff);
+    uint32_t get() const { return _flags; }
+    uint32_t wait_all(uint32_t flags = 0, uint32_t timeout = 0xffffffff,
+            bool clear = true);
+    uint32_t wait_any(uint32_t flags = 0, uint32_t timeout = 0xffffffff,
+            bool clear = true);
+
+private:
+    uint32_t wait(uint32_t flags, bool all, uint32_t timeout, bool clear);
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    volatile uint32_t _flags;
+};
+
+}
+
+using namespace mbed;
+using namespace rtos;
+
+// if *ptr is *expected swap in desired, otherwise update *expected
+static inline bool core_util_atomic_cas_u8(volatile uint8_t *ptr,
+        uint8_t *expected, uint8_t desired) {
+    return __atomic_compare_exchange_n(ptr, expected, desired, false,
+            __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+void wait_ms(int ms);
+void wait_us(int us);
+void wait(float s);
+
+#endif
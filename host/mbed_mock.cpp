@@ -0,0 +1,115 @@
+#include "mbed.h"
+#include <thread>
+#include <unistd.h>
+
+namespace mbed {
+
+void Timer::start() {
+    if (!_running) {
+        _start = HOST_GetTime();
+        _running = true;
+    }
+}
+
+void Timer::stop() {
+    if (_running) {
+        _time += HOST_GetTime() - _start;
+        _running = false;
+    }
+}
+
+void Timer::reset() {
+    _start = HOST_GetTime();
+    _time = 0;
+}
+
+uint64_t Timer::read_high_resolution_us() {
+    return _time + (_running ? HOST_GetTime() - _start : 0);
+}
+
+}
+
+namespace rtos {
+
+osStatus Thread::start(mbed::Callback<void()> task) {
+    std::thread(task).detach();
+    return osOK;
+}
+
+// the timeout is in simulated time, but we only need forever or polling
+int32_t Semaphore::wait(uint32_t millisec) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (millisec == osWaitForever) {
+        while (_count <= 0) {
+            _cond.wait(lock);
+        }
+    } else if (_count <= 0) {
+        return 0;
+    }
+
+    return _count--;
+}
+
+osStatus Semaphore::release() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _count += 1;
+    _cond.notify_one();
+    return osOK;
+}
+
+uint32_t EventFlags::set(uint32_t flags) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _flags |= flags;
+    return _flags;
+}
+
+uint32_t EventFlags::clear(uint32_t flags) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint32_t prev = _flags;
+    _flags &= ~flags;
+    return prev;
+}
+
+uint32_t EventFlags::wait_all(uint32_t flags, uint32_t timeout, bool clear) {
+    return wait(flags, true, timeout, clear);
+}
+
+uint32_t EventFlags::wait_any(uint32_t flags, uint32_t timeout, bool clear) {
+    return wait(flags, false, timeout, clear);
+}
+
+// Our flags are only ever set from interrupts, so instead of sleeping
+// on a condition variable let the board run until the next one. The
+// timeout is ignored, we only ever wait forever.
+uint32_t EventFlags::wait(uint32_t flags, bool all, uint32_t timeout,
+        bool clear) {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            uint32_t got = _flags & flags;
+            if (all ? got == flags : got != 0) {
+                uint32_t res = _flags;
+                if (clear) {
+                    _flags &= ~flags;
+                }
+                return res;
+            }
+        }
+
+        HOST_WaitForInterrupt();
+    }
+}
+
+}
+
+void wait_us(int us) {
+    HOST_WaitUntil(HOST_GetTime() + us);
+}
+
+void wait_ms(int ms) {
+    wait_us(ms*1000);
+}
+
+void wait(float s) {
+    wait_us((int)(s*1000000));
+}
@@ -0,0 +1,7 @@
+#ifndef HOST_PIN_MUX_H
+#define HOST_PIN_MUX_H
+
+// no pins on a host, this brings up the simulated board instead
+void BOARD_InitPins(void);
+
+#endif
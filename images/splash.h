@@ -0,0 +1,116 @@
+// generated by tools/bmp2image from images/splash.bmp, don't edit
+#ifndef SPLASH_IMAGE_H
+#define SPLASH_IMAGE_H
+
+#include <stdint.h>
+
+// 480x272 1-bit, rle+xor
+static const uint8_t splash_image[1672] = {
+    0x4c, 0x59, 0x4b, 0x49, 0xe0, 0x01, 0x10, 0x01, 0x01, 0x03, 0x02, 0x00, 0x00, 0xff, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x9b, 0x00,
+    0x00, 0x20, 0x81, 0x00, 0x01, 0x01, 0x80, 0xb2, 0x00, 0x00, 0x10, 0x9d, 0x00, 0x02, 0x0f, 0xff,
+    0x80, 0x83, 0x00, 0x02, 0x01, 0xff, 0xf0, 0x80, 0x00, 0x06, 0x01, 0xff, 0xc0, 0x00, 0x03, 0xff,
+    0xe0, 0x87, 0x00, 0x00, 0x02, 0x98, 0x00, 0x15, 0xf0, 0x00, 0x70, 0x1f, 0xff, 0xc0, 0x00, 0x7f,
+    0xff, 0x06, 0x00, 0x0c, 0x00, 0xff, 0xfe, 0x0e, 0x00, 0x38, 0x00, 0x0c, 0x00, 0x1c, 0x82, 0x00,
+    0x00, 0x08, 0x84, 0x00, 0x02, 0x07, 0xff, 0xfe, 0x80, 0x00, 0x00, 0x3f, 0x80, 0xff, 0x03, 0xc0,
+    0x1f, 0xff, 0xff, 0x87, 0x00, 0x03, 0x03, 0x00, 0x00, 0x0c, 0x83, 0x00, 0x02, 0x18, 0x00, 0x03,
+    0x80, 0x00, 0x06, 0x30, 0x00, 0x06, 0x00, 0x30, 0x00, 0x03, 0x82, 0x00, 0x00, 0x40, 0x81, 0x00,
+    0x00, 0x04, 0x81, 0x00, 0x01, 0x01, 0xc0, 0x87, 0x00, 0x00, 0xf0, 0x86, 0x00, 0x03, 0x0c, 0x00,
+    0x00, 0x02, 0x83, 0x00, 0x00, 0x20, 0x82, 0x00, 0x07, 0x40, 0x00, 0x01, 0x00, 0xc0, 0x00, 0x00,
+    0x80, 0x81, 0x00, 0x00, 0x04, 0x87, 0x00, 0x00, 0x30, 0x87, 0x00, 0x00, 0x0e, 0x86, 0x00, 0x04,
+    0x30, 0x00, 0x00, 0x01, 0x80, 0x82, 0x00, 0x00, 0x40, 0x82, 0x00, 0x03, 0x80, 0x00, 0x00, 0x81,
+    0x80, 0x00, 0x00, 0x60, 0x86, 0x00, 0x00, 0x08, 0x82, 0x00, 0x00, 0x0c, 0x87, 0x00, 0x01, 0x01,
+    0x80, 0x85, 0x00, 0x00, 0x40, 0x80, 0x00, 0x00, 0x40, 0x82, 0x00, 0x05, 0x80, 0x00, 0x01, 0x00,
+    0x00, 0x01, 0x80, 0x00, 0x00, 0x42, 0x80, 0x00, 0x00, 0x10, 0x81, 0x00, 0x00, 0x02, 0x82, 0x00,
+    0x00, 0x40, 0x81, 0x00, 0x00, 0x02, 0x88, 0x00, 0x00, 0x40, 0x85, 0x00, 0x00, 0x80, 0x80, 0x00,
+    0x00, 0x20, 0x8b, 0x00, 0x00, 0x24, 0x80, 0x00, 0x00, 0x08, 0x86, 0x00, 0x00, 0x10, 0x82, 0x00,
+    0x00, 0x01, 0x88, 0x00, 0x00, 0x30, 0x84, 0x00, 0x00, 0x01, 0x89, 0x00, 0x00, 0x02, 0x83, 0x00,
+    0x00, 0x18, 0x9c, 0x00, 0x00, 0x08, 0x84, 0x00, 0x00, 0x02, 0x94, 0x00, 0x00, 0x04, 0x81, 0x00,
+    0x00, 0x81, 0x85, 0x00, 0x0e, 0x0f, 0xf0, 0x00, 0x80, 0x00, 0x00, 0x3f, 0xff, 0xff, 0xc0, 0x00,
+    0x1f, 0xf8, 0x00, 0x06, 0x84, 0x00, 0x00, 0x04, 0x94, 0x00, 0x00, 0x02, 0x86, 0x00, 0x00, 0x20,
+    0x81, 0x00, 0x02, 0x0e, 0x00, 0x40, 0x85, 0x00, 0x02, 0x07, 0x80, 0x01, 0x84, 0x00, 0x00, 0x08,
+    0x89, 0x00, 0x00, 0x04, 0x8d, 0x00, 0x00, 0x80, 0x85, 0x00, 0x01, 0x01, 0x80, 0x87, 0x00, 0x02,
+    0x70, 0x00, 0x80, 0x83, 0x00, 0x00, 0x10, 0x9e, 0x00, 0x01, 0x40, 0x20, 0x81, 0x00, 0x00, 0x40,
+    0x87, 0x00, 0x00, 0x0c, 0x85, 0x00, 0x00, 0x20, 0x89, 0x00, 0x00, 0x08, 0x87, 0x00, 0x00, 0x01,
+    0x82, 0x00, 0x00, 0x40, 0x87, 0x00, 0x00, 0x20, 0x86, 0x00, 0x02, 0x02, 0x00, 0x40, 0x86, 0x00,
+    0x00, 0xff, 0x8a, 0x00, 0x05, 0x03, 0xf0, 0x00, 0x00, 0x01, 0xf8, 0x88, 0x00, 0x00, 0x80, 0x82,
+    0x00, 0x00, 0x20, 0x87, 0x00, 0x02, 0x01, 0x00, 0x20, 0x83, 0x00, 0x04, 0x40, 0x00, 0x03, 0x00,
+    0xe0, 0x83, 0x00, 0x02, 0x01, 0xfe, 0x10, 0x80, 0x00, 0x05, 0x0c, 0x0c, 0x00, 0x00, 0x06, 0x06,
+    0x82, 0x00, 0x02, 0x01, 0x00, 0x20, 0x92, 0x00, 0x01, 0xc0, 0x10, 0x85, 0x00, 0x02, 0x0c, 0x00,
+    0x18, 0x83, 0x00, 0x02, 0x06, 0x01, 0x80, 0x80, 0x00, 0x08, 0x10, 0x02, 0x00, 0x00, 0x08, 0x01,
+    0x00, 0x00, 0x80, 0x84, 0x00, 0x00, 0x01, 0x83, 0x00, 0x00, 0x10, 0x90, 0x00, 0x04, 0x80, 0x00,
+    0x10, 0x00, 0x04, 0x83, 0x00, 0x02, 0x08, 0x00, 0x60, 0x80, 0x00, 0x00, 0x20, 0x80, 0x00, 0x02,
+    0x10, 0x00, 0x80, 0x83, 0x00, 0x00, 0x10, 0x92, 0x00, 0x01, 0x20, 0x08, 0x85, 0x00, 0x02, 0x20,
+    0x00, 0x02, 0x83, 0x00, 0x00, 0x10, 0x82, 0x00, 0x04, 0x40, 0x01, 0x00, 0x00, 0x20, 0x88, 0x00,
+    0x00, 0x02, 0x8f, 0x00, 0x00, 0x10, 0x86, 0x00, 0x02, 0x40, 0x00, 0x01, 0x83, 0x00, 0x00, 0x20,
+    0x82, 0x00, 0x00, 0x80, 0x82, 0x00, 0x00, 0x40, 0x88, 0x00, 0x00, 0x10, 0x8d, 0x00, 0x01, 0x08,
+    0x04, 0x82, 0x00, 0x06, 0x01, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x8a, 0x00, 0x02, 0x80, 0x00,
+    0x40, 0x85, 0x00, 0x03, 0x08, 0x00, 0x00, 0x04, 0x98, 0x00, 0x00, 0x01, 0x86, 0x00, 0x00, 0x40,
+    0x99, 0x00, 0x00, 0x10, 0x88, 0x00, 0x00, 0x04, 0x89, 0x00, 0x00, 0x40, 0x87, 0x00, 0x00, 0x01,
+    0x88, 0x00, 0x05, 0x02, 0x00, 0x04, 0x00, 0x00, 0x08, 0x90, 0x00, 0x00, 0x02, 0x82, 0x00, 0x02,
+    0x02, 0x00, 0x02, 0x86, 0x00, 0x00, 0x80, 0x86, 0x00, 0x00, 0x80, 0x84, 0x00, 0x00, 0x04, 0x81,
+    0x00, 0x00, 0x08, 0x82, 0x00, 0x01, 0x20, 0x20, 0x87, 0x00, 0x00, 0x02, 0x89, 0x00, 0x00, 0x20,
+    0x94, 0x00, 0x01, 0x02, 0x02, 0x86, 0x00, 0x00, 0x40, 0x91, 0x00, 0x00, 0x04, 0x92, 0x00, 0x00,
+    0x20, 0x86, 0x00, 0x01, 0x10, 0x10, 0x82, 0x00, 0x01, 0x80, 0x40, 0xad, 0x00, 0x00, 0x01, 0x81,
+    0x00, 0x00, 0x08, 0x80, 0x00, 0x00, 0x01, 0x81, 0x00, 0x03, 0x3f, 0xff, 0xff, 0x80, 0x81, 0x00,
+    0x00, 0x01, 0x89, 0x00, 0x00, 0x10, 0x94, 0x00, 0x00, 0x01, 0x80, 0x00, 0x01, 0x20, 0x20, 0x81,
+    0x00, 0x02, 0x1e, 0x00, 0x80, 0xab, 0x00, 0x03, 0x04, 0x00, 0x00, 0x80, 0x83, 0x00, 0x02, 0x0f,
+    0xe0, 0x01, 0xae, 0x00, 0x04, 0x80, 0x00, 0x00, 0x40, 0x44, 0x82, 0x00, 0x00, 0x02, 0xad, 0x00,
+    0x00, 0x08, 0x87, 0x00, 0x01, 0x03, 0x80, 0x90, 0x00, 0x00, 0x08, 0x99, 0x00, 0x04, 0x40, 0x40,
+    0x00, 0x80, 0x80, 0x83, 0x00, 0x00, 0x40, 0xb8, 0x00, 0x00, 0x30, 0x90, 0x00, 0x00, 0x08, 0x99,
+    0x00, 0x05, 0x20, 0x20, 0x01, 0x01, 0x00, 0x04, 0x85, 0x00, 0x03, 0x3f, 0xff, 0xff, 0x80, 0xa5,
+    0x00, 0x00, 0x08, 0x89, 0x00, 0x00, 0x08, 0xad, 0x00, 0x02, 0x10, 0x10, 0x02, 0x82, 0x00, 0x03,
+    0x0f, 0xff, 0xc0, 0x04, 0xb0, 0x00, 0x01, 0x02, 0x02, 0x82, 0x00, 0x01, 0x30, 0x02, 0x94, 0x00,
+    0x00, 0x10, 0x94, 0x00, 0x02, 0x10, 0x00, 0x08, 0x85, 0x00, 0x00, 0x0c, 0x88, 0x00, 0x00, 0x01,
+    0xa2, 0x00, 0x03, 0x08, 0x00, 0x04, 0x04, 0x83, 0x00, 0x01, 0x02, 0x01, 0x90, 0x00, 0x00, 0x04,
+    0x9a, 0x00, 0x00, 0x04, 0x98, 0x00, 0x00, 0x02, 0x82, 0x00, 0x00, 0x20, 0x95, 0x00, 0x05, 0x04,
+    0x00, 0x08, 0x08, 0x00, 0x02, 0x81, 0x00, 0x00, 0x01, 0x88, 0x00, 0x00, 0x02, 0x85, 0x00, 0x00,
+    0x02, 0x97, 0x00, 0x00, 0x10, 0xa1, 0x00, 0x00, 0x40, 0x95, 0x00, 0x03, 0x02, 0x02, 0x10, 0x10,
+    0x84, 0x00, 0x00, 0x80, 0x87, 0x00, 0x01, 0x04, 0x02, 0x84, 0x00, 0x00, 0x01, 0x9d, 0x00, 0x00,
+    0x01, 0x95, 0x00, 0x06, 0x01, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x94, 0x00, 0x04, 0x20, 0x01,
+    0x01, 0x20, 0x20, 0x8f, 0x00, 0x01, 0x08, 0x04, 0x85, 0x00, 0x02, 0x40, 0x00, 0x01, 0xb6, 0x00,
+    0x02, 0x20, 0x00, 0x02, 0x97, 0x00, 0x04, 0x80, 0xc0, 0x40, 0x00, 0x01, 0x8d, 0x00, 0x01, 0x10,
+    0x08, 0x83, 0x00, 0x04, 0x80, 0x00, 0x10, 0x00, 0x04, 0x94, 0x00, 0x00, 0x20, 0x89, 0x00, 0x00,
+    0x80, 0x87, 0x00, 0x00, 0x20, 0x86, 0x00, 0x02, 0x0c, 0x00, 0x18, 0xac, 0x00, 0x01, 0x40, 0x10,
+    0x83, 0x00, 0x04, 0x40, 0x00, 0x03, 0x00, 0xe0, 0x97, 0x00, 0x02, 0x40, 0x00, 0x80, 0x83, 0x00,
+    0x00, 0x01, 0x88, 0x00, 0x01, 0x80, 0x20, 0x83, 0x00, 0x03, 0x20, 0x00, 0x00, 0xff, 0xa2, 0x00,
+    0x00, 0x01, 0x86, 0x00, 0x00, 0x03, 0xa2, 0x00, 0x06, 0x40, 0x00, 0x20, 0x01, 0x00, 0x00, 0x80,
+    0x81, 0x00, 0x00, 0x06, 0x87, 0x00, 0x02, 0x0c, 0x00, 0x40, 0x83, 0x00, 0x00, 0x10, 0xa4, 0x00,
+    0x01, 0x08, 0x02, 0x86, 0x00, 0x02, 0x30, 0x00, 0x80, 0x83, 0x00, 0x00, 0x08, 0x98, 0x00, 0x04,
+    0x40, 0x00, 0x00, 0x10, 0x02, 0x80, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x30, 0x86, 0x00, 0x02,
+    0x01, 0xc0, 0x01, 0x84, 0x00, 0x00, 0x04, 0xa2, 0x00, 0x0e, 0x0f, 0xff, 0xc0, 0x04, 0x00, 0x00,
+    0x3f, 0xff, 0xff, 0xc0, 0x00, 0x1f, 0xfe, 0x00, 0x02, 0xa3, 0x00, 0x01, 0x08, 0x04, 0x85, 0x00,
+    0x00, 0x08, 0x87, 0x00, 0x00, 0x0c, 0x84, 0x00, 0x00, 0x03, 0xa5, 0x00, 0x00, 0x10, 0x87, 0x00,
+    0x00, 0x10, 0x85, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x20, 0x96, 0x00, 0x01, 0x04, 0x08, 0x85,
+    0x00, 0x00, 0x20, 0x87, 0x00, 0x00, 0x20, 0x85, 0x00, 0x00, 0x40, 0x80, 0x00, 0x00, 0x40, 0x94,
+    0x00, 0x00, 0x80, 0x82, 0x00, 0x00, 0x40, 0x82, 0x00, 0x00, 0x40, 0x87, 0x00, 0x00, 0xc0, 0x85,
+    0x00, 0x00, 0x20, 0x80, 0x00, 0x00, 0x80, 0x97, 0x00, 0x00, 0x10, 0x84, 0x00, 0x01, 0x01, 0x80,
+    0x86, 0x00, 0x00, 0x07, 0x86, 0x00, 0x03, 0x18, 0x00, 0x00, 0x03, 0x94, 0x00, 0x03, 0x80, 0x00,
+    0x00, 0x02, 0x81, 0x00, 0x00, 0x40, 0x80, 0x00, 0x00, 0x0e, 0x87, 0x00, 0x00, 0x38, 0x86, 0x00,
+    0x03, 0x07, 0x00, 0x00, 0x0c, 0x94, 0x00, 0x00, 0xff, 0x83, 0x00, 0x05, 0x3f, 0xc0, 0x07, 0xff,
+    0xff, 0xf0, 0x83, 0x00, 0x04, 0x40, 0x1f, 0xff, 0xff, 0xc0, 0x87, 0x00, 0x08, 0xe0, 0x00, 0x70,
+    0x1f, 0xff, 0xc0, 0x00, 0x7f, 0xff, 0x81, 0x00, 0x0a, 0xff, 0xfe, 0x00, 0x00, 0x7f, 0xff, 0x00,
+    0x00, 0x1f, 0xff, 0x80, 0x82, 0x00, 0x01, 0x01, 0x20, 0x87, 0x00, 0x00, 0x3f, 0x80, 0xff, 0x00,
+    0x80, 0x8b, 0x00, 0x02, 0x1f, 0xff, 0x80, 0x98, 0x00, 0x00, 0xc0, 0xff, 0x00, 0xff, 0x00, 0xff,
+    0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0x84,
+    0x00, 0x8b, 0xff, 0x00, 0xfe, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xfb, 0x00, 0x0a,
+    0x3f, 0xc0, 0xf0, 0xf0, 0x00, 0x03, 0xc0, 0x00, 0x0f, 0x00, 0x0f, 0xea, 0x00, 0x01, 0xcf, 0x30,
+    0xf2, 0x00, 0x04, 0x03, 0x30, 0xc0, 0x00, 0xf0, 0x82, 0x00, 0x01, 0xc0, 0x30, 0xeb, 0x00, 0x06,
+    0x30, 0x00, 0xf0, 0x3f, 0xc0, 0x03, 0xc0, 0x80, 0x00, 0x01, 0x03, 0xfc, 0xec, 0x00, 0x08, 0xcf,
+    0x30, 0x0c, 0xc0, 0x00, 0x30, 0xc0, 0x0c, 0xf3, 0xed, 0x00, 0x01, 0xf0, 0x33, 0x82, 0x00, 0x00,
+    0xf0, 0xee, 0x00, 0x06, 0x0c, 0x00, 0x00, 0xcf, 0x30, 0x00, 0xff, 0xe9, 0x00, 0x00, 0x30, 0x81,
+    0x00, 0x00, 0x0c, 0xed, 0x00, 0x02, 0x03, 0x30, 0xc0, 0x80, 0x00, 0x07, 0xf0, 0x33, 0x00, 0x00,
+    0x30, 0xc0, 0x00, 0x0f, 0xe8, 0x00, 0x07, 0xcf, 0x30, 0x00, 0x00, 0xcf, 0x30, 0x0c, 0xc0, 0x80,
+    0x00, 0x01, 0x0c, 0xf3, 0xe8, 0x00, 0x07, 0x3f, 0xc0, 0xf0, 0xf0, 0x3f, 0xc3, 0xc3, 0xc0, 0x80,
+    0x0f, 0x01, 0x03, 0xfc, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xb5, 0x00,
+    0x8b, 0xff, 0x00, 0xfe, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0x00,
+    0xff, 0x00, 0xff, 0x00, 0xff, 0x00, 0xdb, 0x00,
+};
+
+#endif
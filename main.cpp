@@ -30,22 +30,96 @@
 
 /*  Standard C Included Files */
 #include "mbed.h"
+#include <math.h>
 #include "LookyTouchy.h"
 #include "GUI.h"
+#include "Particles.h"
+#include "fade.h"
+#include "image.h"
+#include "images/splash.h"
+#include "BDBench.h"
+#include "FSBench.h"
+#include "TraceBlockDevice.h"
+#include "CacheBlockDevice.h"
+#include "SlicingBlockDevice.h"
+#include "Playback.h"
+
+// the demos write 3:3:2 colors and palette indices straight into the
+// frame buffer
+MBED_STATIC_ASSERT(sizeof(Frame::pixel_t) == 1 &&
+        (FormatSame<Frame::format_t, Format332>::value),
+        "the demos only draw into 3:3:2 frames");
+
+// filesystems to compare, the host only has them with mbed-os around
+#ifndef LOOKY_FSBENCH
+#define LOOKY_FSBENCH 1
+#endif
+
+#if LOOKY_FSBENCH
+#include "LittleFileSystem.h"
+#include "FATFileSystem.h"
+#endif
+
+// block device to benchmark, the Makefile picks this for real builds
+#ifndef MBED_TEST_BLOCKDEVICE
+#define MBED_TEST_BLOCKDEVICE HeapBlockDevice
+#define MBED_TEST_BLOCKDEVICE_DECL HeapBlockDevice bd(128*512, 512)
+// which is nowhere near a whole animation, so give it half
+#ifndef LOOKY_ANIM_SIZE
+#define LOOKY_ANIM_SIZE (64*512)
+#endif
+#endif
+
+#define STRINGIZE(x) STRINGIZE2(x)
+#define STRINGIZE2(x) #x
+#define INCLUDE(x) STRINGIZE(x.h)
+#include INCLUDE(MBED_TEST_BLOCKDEVICE)
+
+MBED_TEST_BLOCKDEVICE_DECL;
+
+// benches go through the tracer so we can watch what they do to flash,
+// the tracer only expects one thread so animations stay out of it
+TraceBlockDevice trace(&bd);
+
+// animations stream from the end of the device, benches get the rest
+#ifndef LOOKY_ANIM_SIZE
+#define LOOKY_ANIM_SIZE (4*1024*1024)
+#endif
+
+SlicingBlockDevice bench_bd(&trace, 0, -LOOKY_ANIM_SIZE);
+SlicingBlockDevice anim_bd(&bd, -LOOKY_ANIM_SIZE);
+
+// write-back cache for the filesystems, SRAM is quicker but there's
+// less of it
+#ifndef LOOKY_BD_CACHE_SIZE
+#define LOOKY_BD_CACHE_SIZE (8*1024)
+#endif
+
+#ifndef LOOKY_BD_CACHE_PLACEMENT
+#define LOOKY_BD_CACHE_PLACEMENT LOOKY_SRAM
+#endif
+
+CacheBlockDevice *cache;
 
 LookyTouchy lt;
 enum {
+    SPLASH_MODE,
     CONSOLE_MODE,
     RAIN_MODE,
     STARS_MODE,
     RAINBOW_MODE,
+    FSBENCH_MODE,
+    TRACE_MODE,
+    PLAY_MODE,
+    CLOCK_MODE,
 
     MODE_COUNT,
 };
-int mode = RAIN_MODE;
+int mode = SPLASH_MODE;
 
 void change_mode() {
     mode = (mode+1) % MODE_COUNT;
+    lt.invalidate(0, 0, 380, lt.h());
 }
 
 GUI gui(&lt);
@@ -53,6 +127,57 @@ GUILabel title(&gui, "Hello World!");
 GUIFPS fps(&gui);
 GUISeparator sep(&gui);
 GUIButton button(&gui, "PUSH ME", change_mode);
+GUISpacer spacer(&gui);
+GUIProfile profile(&gui, 7);
+
+// block device and filesystem benchmarks, they share the block device
+// so only one runs at a time
+BDBench *bdbench;
+FSBench *fsbench;
+
+bool benching() {
+    return (bdbench && bdbench->running()) ||
+           (fsbench && fsbench->running());
+}
+
+void bench() {
+    if (bdbench && !benching()) {
+        // we write under the filesystems' cache, so it can't keep
+        // anything it read before
+        if (cache) {
+            cache->invalidate();
+        }
+        trace.reset();
+        bdbench->run();
+    }
+
+    mode = TRACE_MODE;
+    lt.invalidate(0, 0, 380, lt.h());
+}
+
+void fs_bench() {
+    if (fsbench && !benching()) {
+        trace.reset();
+        fsbench->run();
+    }
+
+    mode = FSBENCH_MODE;
+    lt.invalidate(0, 0, 380, lt.h());
+}
+
+// cycles the filesystem cache's policy between runs
+void cache_policy();
+
+GUIButton bench_button(&gui, "BD BENCH", bench);
+GUIButton fs_bench_button(&gui, "FS BENCH", fs_bench);
+GUIButton cache_button(&gui, "CACHE LRU", cache_policy);
+GUIGraph bench_kibps(&gui, "KiB/s", 0x1c);
+GUIGraph bench_latency(&gui, "latency us", 0xe0);
+
+void bench_sample(int test, uint32_t kibps, uint32_t us) {
+    bench_kibps.add(kibps, BDBench::name(test));
+    bench_latency.add(us);
+}
 
 
 struct Console : public Thingy, public FileHandle {
@@ -68,18 +193,27 @@ struct Console : public Thingy, public FileHandle {
         w = f.w() / 5;
         h = f.h() / 11;
 
-        buffer = (char *)lt.alloc(w*h);
+        buffer = (char *)lt.alloc(w*h, LOOKY_SRAM);
         memset(buffer, 0, w*h);
         return 0;
     }
 
+    virtual const char *name() const {
+        return "console";
+    }
+
+    virtual bool animated() const {
+        return false;
+    }
+
     virtual void look(const Frame &f, int dt) {
         if (mode != CONSOLE_MODE) {
             return;
         }
 
+        // frame's already cleared, so opaque text is safe and cheaper
         for (int i = 0; i < y; i++) {
-            f.puts(10, 5+i*11, &buffer[i*w]);
+            f.puts(10, 5+i*11, &buffer[i*w], 0xff, 0x00);
         }
     }
 
@@ -100,6 +234,12 @@ struct Console : public Thingy, public FileHandle {
             y -= 1;
         }
 
+        // only redraw if we're on screen, other modes may be drawing
+        // on top of the last frame
+        if (mode == CONSOLE_MODE) {
+            invalidate();
+        }
+
         return size;
     }
 
@@ -126,199 +266,623 @@ FileHandle *mbed::mbed_override_console(int fd) {
     return &console;
 }
 
+// FSBench results as KiB/s, a column for each pattern on each filesystem
+struct FSTable : public Thingy {
+    virtual const char *name() const {
+        return "fstable";
+    }
+
+    virtual bool animated() const {
+        return false;
+    }
+
+    virtual void look(const Frame &f, int dt) {
+        if (mode != FSBENCH_MODE) {
+            return;
+        }
+
+        if (!fsbench) {
+            f.puts(10, 5, "no filesystems to bench");
+            return;
+        }
+
+        static const char *columns[FSBENCH_PATTERNS] = {
+            "append", "overwr", "rnd rd",
+        };
+
+        // frame's already cleared, so opaque text is safe and cheaper
+        char line[80];
+        int n = snprintf(line, sizeof(line), "%-11s", "KiB/s");
+        for (int i = 0; i < fsbench->count(); i++) {
+            n += snprintf(line+n, sizeof(line)-n,
+                    "%3s%-21.21s", "", fsbench->name(i));
+        }
+        f.puts(10, 5, line, 0xff, 0x00);
+
+        n = snprintf(line, sizeof(line), "%5s%6s", "size", "io");
+        for (int i = 0; i < fsbench->count(); i++) {
+            for (int p = 0; p < FSBENCH_PATTERNS; p++) {
+                n += snprintf(line+n, sizeof(line)-n, "%8s", columns[p]);
+            }
+        }
+        f.puts(10, 16, line, 0xff, 0x00);
+
+        int y = 32;
+        for (int s = 0; s < FSBench::FILE_SIZES; s++) {
+            for (int io = 0; io < FSBench::IO_SIZES; io++) {
+                n = snprintf(line, sizeof(line), "%4luK%6lu",
+                        (unsigned long)FSBench::file_sizes[s]/1024,
+                        (unsigned long)FSBench::io_sizes[io]);
+                for (int i = 0; i < fsbench->count(); i++) {
+                    for (int p = 0; p < FSBENCH_PATTERNS; p++) {
+                        const FSBench::Result &r =
+                                fsbench->result(i, s, io, p);
+                        if (r.ops) {
+                            n += snprintf(line+n, sizeof(line)-n, "%8lu",
+                                    (unsigned long)r.kibps());
+                        } else {
+                            n += snprintf(line+n, sizeof(line)-n,
+                                    "%8s", "-");
+                        }
+                    }
+                }
+                f.puts(10, y, line, 0xff, 0x00);
+                y += 11;
+            }
+            y += 5;
+        }
+
+        // hit rate over everything we ran
+        if (cache) {
+            n = snprintf(line, sizeof(line), "%-11s",
+                    CacheBlockDevice::name(cache->policy()));
+            for (int i = 0; i < fsbench->count(); i++) {
+                uint32_t hits = 0, lookups = 0;
+                for (int s = 0; s < FSBench::FILE_SIZES; s++) {
+                    for (int io = 0; io < FSBench::IO_SIZES; io++) {
+                        for (int p = 0; p < FSBENCH_PATTERNS; p++) {
+                            const CacheBlockDevice::Stats &c =
+                                    fsbench->cache_stats(i, s, io, p);
+                            hits += c.hits;
+                            lookups += c.hits + c.misses;
+                        }
+                    }
+                }
+                unsigned long pct = lookups ? 100*(uint64_t)hits/lookups : 0;
+                n += snprintf(line+n, sizeof(line)-n,
+                        "%3s%3lu%% hits%12s", "", pct, "");
+            }
+            f.puts(10, y, line, 0xff, 0x00);
+        }
+    }
+};
+
+FSTable fstable;
+
+void cache_policy() {
+    static const char *labels[CACHE_POLICIES] = {
+        "CACHE OFF", "CACHE LRU", "CACHE CLOCK",
+    };
+
+    if (cache && !benching()) {
+        cache->policy((cache->policy() + 1) % CACHE_POLICIES);
+        cache_button.printf("%s", labels[cache->policy()]);
+        if (mode == FSBENCH_MODE) {
+            fstable.invalidate();
+        }
+    }
+}
+
+// TraceBlockDevice latencies, and erase counts as a heatmap of blocks
+struct Heatmap : public Thingy {
+    virtual const char *name() const {
+        return "heatmap";
+    }
+
+    virtual bool animated() const {
+        return mode == TRACE_MODE;
+    }
+
+    virtual void look(const Frame &f, int dt) {
+        if (mode != TRACE_MODE) {
+            return;
+        }
+
+        // frame's already cleared, so opaque text is safe and cheaper
+        char line[80];
+        snprintf(line, sizeof(line), "%-8s%8s%8s%8s%8s%8s",
+                "us", "ops", "p50", "p99", "max", "KiB");
+        f.puts(10, 5, line, 0xff, 0x00);
+        for (int i = 0; i < TRACE_OPS; i++) {
+            const TraceBlockDevice::Stats &s = trace.stats(i);
+            snprintf(line, sizeof(line), "%-8s%8lu%8lu%8lu%8lu%8lu",
+                    TraceBlockDevice::name(i),
+                    (unsigned long)s.ops,
+                    (unsigned long)trace.percentile(i, 50),
+                    (unsigned long)trace.percentile(i, 99),
+                    (unsigned long)s.max_us,
+                    (unsigned long)(s.bytes / 1024));
+            f.puts(10, 16 + 11*i, line, 0xff, 0x00);
+        }
+
+        int blocks = trace.blocks();
+        if (!blocks) {
+            return;
+        }
+
+        // biggest square cells that fit, sharing cells if we must
+        const int x = 10, y = 62;
+        const int w = f.w() - 2*x, h = f.h() - y - 5;
+        int s = 1;
+        while ((w/(s+1))*(h/(s+1)) >= blocks) {
+            s += 1;
+        }
+        int cols = w/s;
+        int per = (blocks + cols*(h/s) - 1) / (cols*(h/s));
+
+        // snapshot the counts so the bench thread can't change them
+        // between finding the max and drawing the cells
+        uint16_t *erases = (uint16_t *)lt.scratch().alloc(
+                blocks*sizeof(uint16_t));
+        if (!erases) {
+            return;
+        }
+
+        int max = 1;
+        for (int b = 0; b < blocks; b++) {
+            erases[b] = trace.erases(b);
+            max = (erases[b] > max) ? erases[b] : max;
+        }
+
+        snprintf(line, sizeof(line), "erases, most %d", max);
+        f.puts(10, 49, line, 0xff, 0x00);
+
+        // dim for untouched, then blue through white
+        static const uint8_t heat[8] = {
+            0x25, 0x03, 0x1f, 0x1c, 0xfc, 0xf0, 0xe0, 0xff,
+        };
+        for (int c = 0; c*per < blocks; c++) {
+            int n = 0;
+            for (int b = c*per; b < (c+1)*per && b < blocks; b++) {
+                n = (erases[b] > n) ? erases[b] : n;
+            }
+
+            int level = (n*7 + max-1) / max;
+            f.putrect(x + (c%cols)*s, y + (c/cols)*s,
+                    (s > 1) ? s-1 : 1, (s > 1) ? s-1 : 1, heat[level]);
+        }
+    }
+};
+
+Heatmap heatmap;
+
+// an animation streamed off the end of the block device
+struct Player : public Playback {
+    Player() : Playback(&lt, &anim_bd) {}
+
+    virtual bool animated() const {
+        return mode == PLAY_MODE;
+    }
+
+    virtual void look(const Frame &f, int dt) {
+        if (mode != PLAY_MODE) {
+            return;
+        }
+
+        Playback::look(f, dt);
+    }
+};
+
+Player player;
+
+void fs_bench_done() {
+    if (mode == FSBENCH_MODE) {
+        fstable.invalidate();
+    }
+}
+
+// the splash screen is wider than we are, so pan back and forth over it
+struct Splash : public Thingy {
+    static const int PERIOD = 4000;
+    int t;
+
+    Splash() : t(0) {}
+
+    virtual const char *name() const {
+        return "splash";
+    }
+
+    virtual bool animated() const {
+        return mode == SPLASH_MODE;
+    }
+
+    // the image covers us, no need to clear first
+    virtual bool persistent() const {
+        return true;
+    }
+
+    virtual void look(const Frame &f, int dt) {
+        if (mode != SPLASH_MODE) {
+            return;
+        }
+
+        ImageHeader h;
+        image_info(&h, splash_image, sizeof(splash_image));
+
+        t = (t + dt) % PERIOD;
+        int range = h.w - f.w();
+        int x = (t < PERIOD/2) ? t : PERIOD - t;
+        f.putimage(-(x*range / (PERIOD/2)), 0,
+                splash_image, sizeof(splash_image));
+    }
+};
+
+// anti-aliased clock face, redrawn every frame in its mode, time starts
+// at boot and keeps going while we're in other modes
+struct Clock : public Thingy {
+    Timer timer;
+
+    Clock() {
+        timer.start();
+    }
+
+    virtual const char *name() const {
+        return "clock";
+    }
+
+    virtual bool animated() const {
+        return mode == CLOCK_MODE;
+    }
+
+    // a hand from the middle, turns of the hand in 1/65536ths
+    void hand(const Frame &f, int turns, int r, uint8_t c) {
+        float a = 2.0f*(float)M_PI*(float)turns / 65536.0f;
+        f.putaaline(f.w()/2, f.h()/2,
+                f.w()/2 + (int)(r*sinf(a)), f.h()/2 - (int)(r*cosf(a)), c);
+    }
+
+    virtual void look(const Frame &f, int dt) {
+        if (mode != CLOCK_MODE) {
+            return;
+        }
+
+        int r = ((f.w() < f.h()) ? f.w() : f.h())/2 - 8;
+        f.putaacircle(f.w()/2, f.h()/2, r, 0xff);
+        for (int i = 0; i < 60; i++) {
+            float a = 2.0f*(float)M_PI*(float)i / 60.0f;
+            int in = (i % 5) ? r-6 : r-16;
+            f.putaaline(
+                    f.w()/2 + (int)(in*sinf(a)), f.h()/2 - (int)(in*cosf(a)),
+                    f.w()/2 + (int)((r-2)*sinf(a)),
+                    f.h()/2 - (int)((r-2)*cosf(a)),
+                    (i % 5) ? 0x92 : 0xff);
+        }
+
+        // t is in ms, hands sweep smoothly
+        int t = timer.read_ms();
+        int s = t % 60000;
+        int m = (t / 60) % 60000;
+        int h = (t / 720) % 60000;
+        hand(f, 65536LL*h / 60000, r/2, 0xff);
+        hand(f, 65536LL*m / 60000, r-20, 0xff);
+        hand(f, 65536LL*s / 60000, r-12, 0xe0);
+        f.putaadisc(f.w()/2, f.h()/2, 5, 0xe0);
+    }
+};
+
+// Rainbow is drawn once, the palette does the animating
 struct Rainbow : public Thingy {
-    uint64_t *buffer;
-    int ctr;
+    // palette entries we take over, clear of the GUI's colors
+    static const int FIRST = 0x80;
+    static const int COUNT = 64;
+    uint16_t *hues;
+    int cycle;
 
     virtual int init(const Frame &f) {
-        buffer = (uint64_t*)lt.alloc(f.w()*f.h());
+        hues = (uint16_t *)lt.alloc(COUNT*sizeof(uint16_t), LOOKY_SRAM);
+        if (!hues) {
+            return -ENOMEM;
+        }
+
+        // walk around the color wheel
+        for (int i = 0; i < COUNT; i++) {
+            int h = (6*256*i) / COUNT;
+            int t = h & 0xff;
+            uint8_t r, g, b;
+            switch (h >> 8) {
+                case 0:  r = 0xff;   g = t;      b = 0;      break;
+                case 1:  r = 0xff-t; g = 0xff;   b = 0;      break;
+                case 2:  r = 0;      g = 0xff;   b = t;      break;
+                case 3:  r = 0;      g = 0xff-t; b = 0xff;   break;
+                case 4:  r = t;      g = 0;      b = 0xff;   break;
+                default: r = 0xff;   g = 0;      b = 0xff-t; break;
+            }
+            hues[i] = Palette::rgb(r, g, b);
+        }
+
+        cycle = -1;
         return 0;
     }
 
+    virtual const char *name() const {
+        return "rainbow";
+    }
+
+    virtual bool animated() const {
+        return false;
+    }
+
     virtual void look(const Frame &f, int dt) {
         if (mode != RAINBOW_MODE) {
+            // give our entries back
+            if (cycle >= 0) {
+                lt.palette().stop(cycle);
+                lt.palette().reset(FIRST, COUNT);
+                cycle = -1;
+            }
             return;
         }
 
-        for (int j = 0; j < (f.w()*f.h())/8; j++) {
-            uint64_t x64;
-            uint8_t *x8 = (uint8_t*)&x64;
-            for (int i = 0; i < 8; i++) {
-                x8[i] = ((8*j+i)%f.w() + ((8*j+i)/f.w()) + ctr) / 10;
-            }
-            buffer[j] = x64;
+        // a band every 10 pixels, drifting back a pixel a frame at 60Hz
+        if (cycle < 0) {
+            cycle = lt.palette().cycle(FIRST, COUNT, hues, -256*60/10);
         }
-        ctr += 1;
 
-        f.putbuffer(0, 0, f.w(), f.h(), buffer);
+        for (int y = 0; y < f.h(); y++) {
+            uint8_t *row = f.buffer(0, y);
+            for (int x = 0; x < f.w(); x++) {
+                row[x] = FIRST + ((x + y) / 10) % COUNT;
+            }
+        }
     }
 };
 
-
 struct Stars : public Thingy {
-    uint64_t *buffer;
     int ctr;
+    uint32_t *lit;
 
     virtual int init(const Frame &f) {
-        buffer = (uint64_t*)lt.alloc(f.w()*f.h());
+        ctr = 0;
+
+        // start with everything lit, spans go dark as they fade out
+        size_t size = fade_occupancy_size(f.w(), f.h())*sizeof(uint32_t);
+        lit = (uint32_t *)lt.alloc(size, LOOKY_SRAM);
+        if (!lit) {
+            return -ENOMEM;
+        }
+        memset(lit, 0xff, size);
         return 0;
     }
 
+    virtual const char *name() const {
+        return "stars";
+    }
+
+    virtual bool animated() const {
+        return mode == STARS_MODE;
+    }
+
+    // we fade out whatever we drew last frame, LookyTouchy copies the
+    // previous frame forward so we don't need our own copy
+    virtual bool persistent() const {
+        return true;
+    }
+
+    void spark(const LCDView &v, int i) {
+        int n = v.w()*v.h();
+        i = ((i % n) + n) % n;
+        v.putp(i % v.w(), i / v.w(), 0xff);
+        fade_mark(lit, v.w(), i % v.w(), i / v.w());
+    }
+
     virtual void look(const Frame &f, int dt) {
         if (mode != STARS_MODE) {
             return;
         }
 
-        for (int j = 0; j < (f.w()*f.h())/8; j++) {
-            uint64_t x64 = buffer[j];
-            if (!x64) { continue; }
-
-            uint8_t *x8 = (uint8_t*)&x64;
-            for (int i = 0; i < 8; i++) {
-                x8[i] = (
-                    ((((x8[i]&0xe0) >> 5) ? ((x8[i]&0xe0) >> 5)-!((ctr++)&0x1) : 0) << 5) |
-                    ((((x8[i]&0x1c) >> 2) ? ((x8[i]&0x1c) >> 2)-!((ctr++)&0x1) : 0) << 2) |
-                    ((((x8[i]&0x03) >> 0) ? ((x8[i]&0x03) >> 0)-!((ctr++)&0x3) : 0) << 0));
-            }
-
-            buffer[j] = x64;
-        }
+        // red and green fade every other pixel, blue every fourth,
+        // the pattern shifts each frame so everything fades evenly
+        uint64_t dec = 0x0024002400240024ULL | 0x0000000100000001ULL;
+        int r = 8*(ctr++ % 8);
+        dec = r ? (dec << r) | (dec >> (64-r)) : dec;
+        faderect332(f.buffer(), f.stride(), f.w(), f.h(), dec, lit);
 
+        LCDView v(f);
         int x = rand() % (f.w()*f.h());
-        uint8_t *b = (uint8_t*)buffer;
-        b[(x  )%(f.w()*f.h())] = 0xff;
-        b[(x+1)%(f.w()*f.h())] = 0xff;
-        b[(x+2)%(f.w()*f.h())] = 0xff;
-        b[(x+3)%(f.w()*f.h())] = 0xff;
-        b[(x+4)%(f.w()*f.h())] = 0xff;
-        b[(x-1)%(f.w()*f.h())] = 0xff;
-        b[(x-2)%(f.w()*f.h())] = 0xff;
-        b[(x-3)%(f.w()*f.h())] = 0xff;
-        b[(x-4)%(f.w()*f.h())] = 0xff;
-        b[(x+1*f.w())%(f.w()*f.h())] = 0xff;
-        b[(x+2*f.w())%(f.w()*f.h())] = 0xff;
-        b[(x+3*f.w())%(f.w()*f.h())] = 0xff;
-        b[(x+4*f.w())%(f.w()*f.h())] = 0xff;
-        b[(x-1*f.w())%(f.w()*f.h())] = 0xff;
-        b[(x-2*f.w())%(f.w()*f.h())] = 0xff;
-        b[(x-3*f.w())%(f.w()*f.h())] = 0xff;
-        b[(x-4*f.w())%(f.w()*f.h())] = 0xff;
-
-        f.putbuffer(0, 0, f.w(), f.h(), buffer);
+        for (int i = 1; i <= 4; i++) {
+            spark(v, x + i);
+            spark(v, x - i);
+            spark(v, x + i*f.w());
+            spark(v, x - i*f.w());
+        }
+        spark(v, x);
     }
 };
 
 struct Rain : public Thingy {
     static const int COUNT = 500;
-    struct drop {int x; int y; int vx; int vy;};
-    struct drop *drops;
-    int ctr;
+    static const int S = Particles::SHIFT;
+    Particles drops;
+    Particles::Emitter clouds;
 
     virtual int init(const Frame &f) {
-        drops = (struct drop*)lt.alloc(COUNT*sizeof(struct drop));
-        memset(drops, 0, COUNT*sizeof(struct drop));
+        void *buffer = lt.alloc(Particles::footprint(COUNT, f.w(), f.h()),
+                LOOKY_SRAM);
+        if (!buffer) {
+            return -ENOMEM;
+        }
+
+        drops.init(buffer, COUNT, f.w(), f.h());
+        drops.gravity = 10;                 // ~0.01 pixels/frame^2
+        drops.damping = (99 << 16) / 100;   // air resistance
+
+        // n raindrops a frame so we actually use all memory locations,
+        // spawned just above the top
+        clouds.x = 0;
+        clouds.y = -8;
+        clouds.w = f.w();
+        clouds.h = 1;
+        clouds.vx = 0;
+        clouds.vy = 0;
+        clouds.spread = 0;
+        clouds.rate = (COUNT/(f.h()+8)) | 1;
         return 0;
     }
 
+    virtual const char *name() const {
+        return "rain";
+    }
+
+    virtual bool animated() const {
+        return mode == RAIN_MODE;
+    }
+
     virtual void look(const Frame &f, int dt) {
         if (mode != RAIN_MODE) {
             return;
         }
 
-        //draw all raindrops
-        for (int i = 0; i < COUNT; i++) {
-            if (drops[i].y <= 0) {
-                continue;
-            }
+        drops.update();
 
+        //draw all raindrops, x wraps and y is checked so these are
+        //always in bounds
+        LCDView v(f);
+        for (int i = 0; i < drops.count(); i++) {
             int tx = 0;
             int ty = 0;
             for (int j = 0; j < 8; j++) {
-                int x = ((drops[i].x+tx)/1000);
-                int y = f.h() - ((drops[i].y+ty)/1000);
+                int x = (drops.x[i]+tx) >> S;
+                int y = (drops.y[i]+ty) >> S;
                 int b = (j > 3) ? 3   : j;
                 int w = j;
                 uint8_t c = ((w << 5) | (w << 2) | (b << 0));
 
-                if (y >= 0 && y < f.h()) {
-                    f.putp((unsigned)x % f.w(), y, c);
-                } else if (y >= f.h()) {
-                    int d = (y-f.h())/2;
-                    f.putp((unsigned)(x-d) % f.w(), f.h()-1, c);
-                    f.putp((unsigned)(x+d) % f.w(), f.h()-1, c);
+                if (y >= 0 && y < v.h()) {
+                    v.putp((unsigned)x % v.w(), y, c);
+                } else if (y >= v.h()) {
+                    int d = (y-v.h())/2;
+                    v.putp((unsigned)(x-d) % v.w(), v.h()-1, c);
+                    v.putp((unsigned)(x+d) % v.w(), v.h()-1, c);
                 }
 
-                tx += drops[i].vx;
-                ty += drops[i].vy;
+                tx += drops.vx[i];
+                ty += drops.vy[i];
             }
+        }
 
-            // update based on veloctiy
-            drops[i].x += drops[i].vx;
-            drops[i].y += drops[i].vy;
+        drops.emit(clouds);
+    }
 
-            // add in "gravity"
-            drops[i].vy -= 10;
+    // pushes drops away from a touch
+    struct Push {
+        Particles &drops;
+        int x;
 
-            // account for air resistance
-            drops[i].vx = drops[i].vx - drops[i].vx/100;
-            drops[i].vy = drops[i].vy - drops[i].vy/100;
-        }
+        Push(Particles &drops, int x) : drops(drops), x(x) {}
 
-        // n raindrops so we actually use all memory locations
-        // generate them
-        for (int i = 0; i < ((COUNT/(f.h()+8)) | 1); i++) {
-            drops[ctr].x = (rand() % f.w())*1000;
-            drops[ctr].y = (f.h() + 8)*1000;
-            drops[ctr].vx = 0;
-            drops[ctr].vy = 0;
-            ctr = (ctr+1) % COUNT;
+        void operator()(int i) {
+            if (drops.x[i] < x) {
+                drops.vx[i] -= drops.vy[i]/2;
+            } else {
+                drops.vx[i] += drops.vy[i]/2;
+            }
+            drops.vy[i] = 0;
         }
-    }
+    };
 
     virtual void touch(const Frame &f, int x, int y) {
         if (x == -1) {
             return;
         }
 
-        x = x*1000;
-        y = (f.h() - y)*1000;
-
-        for (int i = 0; i < COUNT; i++) {
-            int dx = (drops[i].x/1000)-(x/1000);
-            int dy = (drops[i].y/1000)-(y/1000);
-            int d = dx*dx + dy*dy;
+        Push push(drops, x << S);
+        drops.index();
+        drops.query(x, y, 32, push);
+    }
+};
 
-            // find distance
-            if (d > 1000) { continue; }
+// arena usage in bytes, the high-water mark is the most ever used
+void print_arenas() {
+    printf("%-8s%10s%10s%10s\n", "arena", "used", "high", "size");
+    for (Arena *a = Arena::first(); a; a = a->next()) {
+        printf("%-8s%10lu%10lu%10lu\n", a->name(),
+                (unsigned long)a->used(),
+                (unsigned long)a->highwater(),
+                (unsigned long)a->size());
+    }
+}
 
-            // add our force
-            if (drops[i].x < x) {
-                drops[i].vx -= -drops[i].vy/2;
-            } else {
-                drops[i].vx += -drops[i].vy/2;
-            }
-            drops[i].vy = 0;
-        }
+// sum of high-water marks, so we can tell when any of them moves
+size_t arenas_highwater() {
+    size_t highwater = 0;
+    for (Arena *a = Arena::first(); a; a = a->next()) {
+        highwater += a->highwater();
     }
-};
+    return highwater;
+}
 
 int main(void) {
     lt.add(380, 0, lt.w()-380, lt.h(), &gui);
+    lt.add(  0, 0,        380, lt.h(), new Splash);
     lt.add(  0, 0,        380, lt.h(), &console);
     lt.add(  0, 0,        380, lt.h(), new Stars);
     lt.add(  0, 0,        380, lt.h(), new Rainbow);
     lt.add(  0, 0,        380, lt.h(), new Rain);
+    lt.add(  0, 0,        380, lt.h(), &fstable);
+    lt.add(  0, 0,        380, lt.h(), &heatmap);
+    lt.add(  0, 0,        380, lt.h(), &player);
+    lt.add(  0, 0,        380, lt.h(), new Clock);
 
     int err = lt.start();
     assert(!err);
 
+    // 4 KiB ios over the first 256 KiB of the block device
+    bdbench = new BDBench(&bench_bd, lt.alloc(4096), 4096, 256*1024);
+    bdbench->attach(bench_sample);
+    err = bdbench->start();
+    if (err) {
+        printf("bd bench couldn't start %d\n", err);
+    }
+
+    err = player.start();
+    if (err) {
+        printf("playback couldn't start %d\n", err);
+    }
+
+#if LOOKY_FSBENCH
+    // LittleFS and FAT take turns on the same block device
+    cache = new CacheBlockDevice(&bench_bd,
+            lt.alloc(LOOKY_BD_CACHE_SIZE, LOOKY_BD_CACHE_PLACEMENT),
+            LOOKY_BD_CACHE_SIZE);
+    fsbench = new FSBench(cache, lt.alloc(4096));
+    fsbench->cache(cache);
+    fsbench->add(new LittleFileSystem("lfs"));
+    fsbench->add(new FATFileSystem("fat"));
+    fsbench->attach(fs_bench_done);
+    err = fsbench->start();
+    if (err) {
+        printf("fs bench couldn't start %d\n", err);
+    }
+#endif
+
+    // what startup took out of each pool
+    print_arenas();
+
     printf("Hello!\n");
     printf("Test test test\n");
     printf("Is this thing on?\n");
 
     int i = 0;
+    size_t highwater = arenas_highwater();
     while (true) {
         printf("ping %d\n", i++);
+
+        // only report arenas when they've grown
+        if (arenas_highwater() != highwater) {
+            highwater = arenas_highwater();
+            print_arenas();
+        }
+
         wait_ms(100);
     }
 
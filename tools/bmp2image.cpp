@@ -0,0 +1,184 @@
+// Converts uncompressed BMPs into Looky images, see Looky/image.h
+//
+// usage: bmp2image in.bmp name > name.h
+//
+// Paletted BMPs keep their bit depth and palette, colors get rounded to
+// 3:3:2. 16/24/32-bit BMPs become 8-bit 3:3:2 without a palette. Rows
+// are RLE-coded, with or without the XOR filter, whichever comes out
+// smallest.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <vector>
+#include "image.h"
+#include "rle.h"
+
+static uint32_t le(const std::vector<uint8_t> &b, size_t off, int bytes) {
+    uint32_t x = 0;
+    for (int i = bytes-1; i >= 0; i--) {
+        x = (x << 8) | b[off+i];
+    }
+    return x;
+}
+
+static uint8_t rgb332(int r, int g, int b) {
+    return (r & 0xe0) | ((g & 0xe0) >> 3) | ((b & 0xc0) >> 6);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s in.bmp name > name.h\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        fprintf(stderr, "couldn't open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<uint8_t> bmp;
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        bmp.push_back(c);
+    }
+    fclose(f);
+
+    if (bmp.size() < 54 || bmp[0] != 'B' || bmp[1] != 'M') {
+        fprintf(stderr, "%s isn't a BMP\n", argv[1]);
+        return 1;
+    }
+
+    uint32_t data = le(bmp, 10, 4);
+    uint32_t info = le(bmp, 14, 4);
+    int w = (int32_t)le(bmp, 18, 4);
+    int h = (int32_t)le(bmp, 22, 4);
+    int bpp = le(bmp, 28, 2);
+    uint32_t compression = le(bmp, 30, 4);
+    uint32_t colors = le(bmp, 46, 4);
+
+    // positive heights are stored bottom-up
+    bool flip = h > 0;
+    h = flip ? h : -h;
+    if (compression != 0) {
+        fprintf(stderr, "%s is compressed, not supported\n", argv[1]);
+        return 1;
+    }
+    if (w <= 0 || w > 0xffff || h > 0xffff ||
+            !(bpp == 1 || bpp == 4 || bpp == 8 ||
+              bpp == 16 || bpp == 24 || bpp == 32)) {
+        fprintf(stderr, "%s is %dx%d %d-bit, not supported\n",
+                argv[1], w, h, bpp);
+        return 1;
+    }
+
+    size_t bmpstride = ((size_t)w*bpp + 31) / 32 * 4;
+    if (data + bmpstride*h > bmp.size()) {
+        fprintf(stderr, "%s is truncated\n", argv[1]);
+        return 1;
+    }
+
+    // palette to 3:3:2, entries are BGRX
+    ImageHeader hdr;
+    std::vector<uint8_t> palette;
+    if (bpp <= 8) {
+        colors = colors ? colors : 1 << bpp;
+        for (uint32_t i = 0; i < colors; i++) {
+            size_t p = 14 + info + 4*i;
+            palette.push_back(rgb332(bmp[p+2], bmp[p+1], bmp[p+0]));
+        }
+        hdr.bpp = bpp;
+    } else {
+        hdr.bpp = 8;
+    }
+
+    // packed rows, top-down
+    int ppb = 8 / hdr.bpp;
+    size_t rowbytes = (w + ppb-1) / ppb;
+    std::vector<uint8_t> rows(rowbytes*h);
+    for (int y = 0; y < h; y++) {
+        const uint8_t *src = &bmp[data + bmpstride*(flip ? h-1-y : y)];
+        uint8_t *dst = &rows[rowbytes*y];
+        if (bpp <= 8) {
+            // BMP already packs msb first
+            memcpy(dst, src, rowbytes);
+            if (w % ppb) {
+                dst[rowbytes-1] &= 0xff << (8 - (w % ppb)*bpp);
+            }
+        } else {
+            for (int x = 0; x < w; x++) {
+                const uint8_t *p = &src[x*bpp/8];
+                if (bpp == 16) {
+                    // uncompressed 16-bit is always 5:5:5
+                    int x16 = p[0] | p[1] << 8;
+                    dst[x] = rgb332((x16 >> 7) & 0xf8, (x16 >> 2) & 0xf8,
+                            (x16 << 3) & 0xf8);
+                } else {
+                    dst[x] = rgb332(p[2], p[1], p[0]);
+                }
+            }
+        }
+    }
+
+    // try each coding, keep the smallest
+    std::vector<uint8_t> pixels = rows;
+    hdr.flags = 0;
+
+    std::vector<uint8_t> rle(rle_bound(rows.size()));
+    rle.resize(rle_encode(&rle[0], &rows[0], rows.size()));
+    if (rle.size() < pixels.size()) {
+        pixels = rle;
+        hdr.flags = IMAGE_RLE;
+    }
+
+    if (rowbytes <= IMAGE_MAX_ROW) {
+        std::vector<uint8_t> xored = rows;
+        for (size_t i = rows.size()-1; i >= rowbytes; i--) {
+            xored[i] ^= rows[i - rowbytes];
+        }
+
+        std::vector<uint8_t> xrle(rle_bound(rows.size()));
+        xrle.resize(rle_encode(&xrle[0], &xored[0], xored.size()));
+        if (xrle.size() < pixels.size()) {
+            pixels = xrle;
+            hdr.flags = IMAGE_RLE | IMAGE_XOR;
+        }
+    }
+
+    hdr.magic = IMAGE_MAGIC;
+    hdr.w = w;
+    hdr.h = h;
+    hdr.colors = palette.size();
+
+    std::vector<uint8_t> img((uint8_t*)&hdr, (uint8_t*)(&hdr+1));
+    img.insert(img.end(), palette.begin(), palette.end());
+    img.insert(img.end(), pixels.begin(), pixels.end());
+
+    const char *coding = (hdr.flags & IMAGE_XOR) ? ", rle+xor"
+            : (hdr.flags & IMAGE_RLE) ? ", rle" : "";
+    fprintf(stderr, "%s: %dx%d %d-bit, %d bytes -> %d bytes%s\n",
+            argv[1], w, h, hdr.bpp, (int)bmp.size(), (int)img.size(),
+            coding);
+
+    const char *name = argv[2];
+    char guard[256];
+    size_t i = 0;
+    for (; name[i] && i < sizeof(guard)-1; i++) {
+        guard[i] = toupper(name[i]);
+    }
+    guard[i] = '\0';
+
+    printf("// generated by tools/bmp2image from %s, don't edit\n", argv[1]);
+    printf("#ifndef %s_IMAGE_H\n", guard);
+    printf("#define %s_IMAGE_H\n\n", guard);
+    printf("#include <stdint.h>\n\n");
+    printf("// %dx%d %d-bit%s\n", w, h, hdr.bpp, coding);
+    printf("static const uint8_t %s_image[%d] = {", name, (int)img.size());
+    for (size_t i = 0; i < img.size(); i++) {
+        printf("%s0x%02x,", (i % 16) ? " " : "\n    ", img[i]);
+    }
+    printf("\n};\n\n");
+    printf("#endif\n");
+    return 0;
+}